@@ -0,0 +1,172 @@
+#ifndef BINARY_EVENTS_H
+#define BINARY_EVENTS_H
+
+#include "Order.h"
+#include "ExecutionReport.h"
+#include "ResultSink.h"
+#include "SymbolTable.h"
+#include "MappedFile.h"
+#include "BufferedWriter.h"
+#include "BinaryFormat.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// Journal d'événements binaire (voir BinaryFormat.h) : un enregistrement de taille fixe par événement
+// du moteur, numéroté dans l'ordre d'émission. bin2csv en régénère le CSV de sortie à l'identique.
+
+// Enregistrement d'un événement : numéro de séquence puis champs de ExecutionReport
+struct EventRecord {
+    uint64_t sequence;          // 0, 1, 2... dans l'ordre d'émission
+    uint64_t timestamp;
+    uint64_t order_id;
+    uint64_t counterparty_id;   // Rejet : référence des textes bruts (0 = aucun)
+    uint64_t quantity;
+    uint64_t executed_quantity;
+    int64_t price;              // En ticks de l'instrument
+    int64_t execution_price;
+    uint32_t instrument;        // Identifiant dans la table du fichier
+    uint8_t side;
+    uint8_t type;
+    uint8_t action;
+    uint8_t status;
+};
+
+static_assert(sizeof(EventRecord) == 72, "EventRecord layout is part of the file format");
+
+// Écrit les événements du moteur dans un journal binaire au fil de l'eau.
+// La table des instruments est écrite par close() (ou à la destruction) : `symbols` doit vivre jusque-là.
+class BinaryEventSink : public ResultSink {
+private:
+    BufferedWriter file;
+    const SymbolTable& symbols;
+    uint64_t rows;
+
+public:
+    BinaryEventSink(const std::string& filename, const SymbolTable& symbol_table);
+    ~BinaryEventSink();
+
+    bool is_open() const { return file.is_open(); }
+    uint64_t row_count() const { return rows; }
+
+    void on_report(const ExecutionReport& report) override;
+    void flush() override { file.flush(); }
+
+    // Termine le fichier (table et en-tête) ; std::runtime_error en cas d'échec d'écriture
+    void close();
+};
+
+// Lecture d'un journal d'événements binaire
+class BinaryEventFile {
+public:
+    static constexpr char magic[8] = {'M', 'E', 'E', 'V', 'E', 'N', 'T', 'S'};
+    static constexpr uint32_t version = 1;
+
+    // Charge la table du fichier dans `symbols` puis appelle `on_report` pour chaque événement, dans l'ordre.
+    // Retourne false si le fichier ne peut pas être ouvert ; std::runtime_error s'il n'est pas valide.
+    template <typename Callback>
+    static bool for_each_report(const std::string& filename, SymbolTable& symbols, Callback on_report);
+
+    template <typename Callback>
+    static void for_each_report_in(std::string_view contents, SymbolTable& symbols, Callback on_report);
+};
+
+// Implémentation
+
+BinaryEventSink::BinaryEventSink(const std::string& filename, const SymbolTable& symbol_table)
+    : symbols(symbol_table), rows(0) {
+    if (file.open(filename)) {
+        BinaryFormat::write_placeholder(file);
+    }
+}
+
+BinaryEventSink::~BinaryEventSink() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Pas d'exception dans un destructeur : appeler close() pour connaître l'erreur
+    }
+}
+
+void BinaryEventSink::on_report(const ExecutionReport& report) {
+    EventRecord record;
+    record.sequence = rows;
+    record.timestamp = report.timestamp;
+    record.order_id = report.order_id;
+    record.counterparty_id = report.counterparty_id;
+    record.quantity = report.quantity;
+    record.executed_quantity = report.executed_quantity;
+    record.price = report.price;
+    record.execution_price = report.execution_price;
+    record.instrument = report.instrument;
+    record.side = static_cast<uint8_t>(report.side);
+    record.type = static_cast<uint8_t>(report.type);
+    record.action = static_cast<uint8_t>(report.action);
+    record.status = static_cast<uint8_t>(report.status);
+    file.write(std::string_view(reinterpret_cast<const char*>(&record), sizeof(record)));
+    rows++;
+}
+
+void BinaryEventSink::close() {
+    if (!file.is_open()) return;
+    BinaryFormat::write_table_and_header(file, symbols, BinaryEventFile::magic, BinaryEventFile::version,
+                                         sizeof(EventRecord), rows);
+    file.close();
+}
+
+template <typename Callback>
+bool BinaryEventFile::for_each_report(const std::string& filename, SymbolTable& symbols, Callback on_report) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Could not open input file: " << filename << std::endl;
+        return false;
+    }
+    file.load();
+    for_each_report_in(file.contents(), symbols, on_report);
+    return true;
+}
+
+template <typename Callback>
+void BinaryEventFile::for_each_report_in(std::string_view contents, SymbolTable& symbols, Callback on_report) {
+    BinaryFileHeader header = BinaryFormat::read_header(contents, magic, version, sizeof(EventRecord));
+    std::vector<SymbolId> instrument_ids;
+    std::vector<uint32_t> raw_refs;
+    BinaryFormat::read_table(contents, header, symbols, instrument_ids, raw_refs);
+
+    const char* records = contents.data() + header.records_offset;
+    for (uint64_t i = 0; i < header.record_count; ++i) {
+        EventRecord record;
+        std::memcpy(&record, records + i * sizeof(EventRecord), sizeof(EventRecord));
+        if (record.sequence != i) throw std::runtime_error("Invalid binary file: event out of sequence");
+        bool rejected = record.status == static_cast<uint8_t>(Status::REJECTED);
+        if (record.instrument >= header.symbol_count ||
+            (rejected && record.counterparty_id != 0 && record.counterparty_id >= header.raw_field_count)) {
+            throw std::runtime_error("Invalid binary file: unknown table reference");
+        }
+        if (record.side > static_cast<uint8_t>(Side::SELL) || record.type > static_cast<uint8_t>(OrderType::MARKET) ||
+            record.action > static_cast<uint8_t>(Action::CANCEL) || record.status > static_cast<uint8_t>(Status::REJECTED)) {
+            throw std::runtime_error("Invalid binary file: unknown enumeration value");
+        }
+
+        ExecutionReport report;
+        report.timestamp = record.timestamp;
+        report.order_id = record.order_id;
+        report.counterparty_id = record.counterparty_id;
+        if (rejected) report.raw_text = raw_refs[record.counterparty_id];
+        report.quantity = record.quantity;
+        report.executed_quantity = record.executed_quantity;
+        report.price = record.price;
+        report.execution_price = record.execution_price;
+        report.instrument = instrument_ids[record.instrument];
+        report.side = static_cast<Side>(record.side);
+        report.type = static_cast<OrderType>(record.type);
+        report.action = static_cast<Action>(record.action);
+        report.status = static_cast<Status>(record.status);
+        on_report(report);
+    }
+}
+
+#endif // BINARY_EVENTS_H
@@ -0,0 +1,176 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include "Order.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include "BufferedWriter.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Structure commune des fichiers binaires (ordres d'entrée, journal d'événements) :
+//
+//   [en-tête 64 octets][enregistrements de taille fixe][table des instruments][textes bruts des rejets]
+//
+// Entiers little-endian (ordre natif des machines visées). La table des instruments donne, pour chaque
+// identifiant, sa taille de tick (units, decimals) puis son nom ; les textes bruts (côté, type, action)
+// des ordres rejetés suivent dans l'ordre de leurs références. Chaque texte est précédé de sa longueur
+// sur 32 bits. La table n'est connue qu'en fin d'écriture : l'en-tête est complété à la fermeture.
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Binary files are little-endian");
+
+struct BinaryFileHeader {
+    char magic[8];              // Type de fichier
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+    uint64_t records_offset;
+    uint64_t symbols_offset;    // Table des instruments puis textes bruts, jusqu'à la fin du fichier
+    uint32_t symbol_count;
+    uint32_t raw_field_count;   // Références 1..raw_field_count - 1
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(BinaryFileHeader) == 64, "BinaryFileHeader layout is part of the file format");
+
+// Lecture et écriture de l'en-tête et de la table des fichiers binaires
+class BinaryFormat {
+public:
+    static bool has_magic(std::string_view contents, const char (&magic)[8]) {
+        return contents.size() >= sizeof(magic) && std::memcmp(contents.data(), magic, sizeof(magic)) == 0;
+    }
+
+    // En-tête vérifié (type, version, taille et nombre d'enregistrements) ; std::runtime_error sinon
+    static BinaryFileHeader read_header(std::string_view contents, const char (&magic)[8], uint32_t version,
+                                        uint32_t record_size);
+
+    // Ajoute les instruments (avec leur taille de tick) et les textes bruts du fichier à `symbols`.
+    // `instrument_ids` reçoit l'identifiant local de chaque identifiant du fichier, `raw_refs` la référence
+    // locale de chaque référence de textes bruts du fichier (0 -> 0).
+    static void read_table(std::string_view contents, const BinaryFileHeader& header, SymbolTable& symbols,
+                           std::vector<SymbolId>& instrument_ids, std::vector<uint32_t>& raw_refs);
+
+    // En-tête provisoire (sans type : un fichier interrompu n'est pas reconnu)
+    static void write_placeholder(BufferedWriter& file);
+    // Écrit la table à la suite des enregistrements puis l'en-tête définitif
+    static void write_table_and_header(BufferedWriter& file, const SymbolTable& symbols, const char (&magic)[8],
+                                       uint32_t version, uint32_t record_size, uint64_t record_count);
+
+private:
+    // Lecture bornée de la table
+    class SectionReader {
+    private:
+        std::string_view data;
+        size_t position;
+
+    public:
+        explicit SectionReader(std::string_view section) : data(section), position(0) {}
+
+        template <typename T>
+        T read() {
+            T value;
+            std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        std::string_view read_text() { return take(read<uint32_t>()); }
+
+        std::string_view take(size_t bytes) {
+            if (bytes > data.size() - position) throw std::runtime_error("Invalid binary file: truncated table");
+            std::string_view section = data.substr(position, bytes);
+            position += bytes;
+            return section;
+        }
+    };
+
+    template <typename T>
+    static void write_value(BufferedWriter& file, const T& value) {
+        file.write(std::string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+    }
+
+    static void write_text(BufferedWriter& file, std::string_view text) {
+        write_value(file, static_cast<uint32_t>(text.size()));
+        file.write(text);
+    }
+};
+
+// Implémentation
+
+BinaryFileHeader BinaryFormat::read_header(std::string_view contents, const char (&magic)[8], uint32_t version,
+                                           uint32_t record_size) {
+    BinaryFileHeader header;
+    if (contents.size() < sizeof(header)) throw std::runtime_error("Invalid binary file: truncated header");
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if (!has_magic(contents, magic) || header.version != version || header.record_size != record_size) {
+        throw std::runtime_error("Invalid binary file: unsupported version");
+    }
+    if (header.records_offset < sizeof(header) || header.symbols_offset > contents.size() ||
+        header.records_offset > header.symbols_offset ||
+        header.record_count > (header.symbols_offset - header.records_offset) / record_size ||
+        // Une entrée d'instrument occupe au moins 16 octets
+        header.symbol_count > (contents.size() - header.symbols_offset) / 16) {
+        throw std::runtime_error("Invalid binary file: inconsistent sizes");
+    }
+    return header;
+}
+
+void BinaryFormat::read_table(std::string_view contents, const BinaryFileHeader& header, SymbolTable& symbols,
+                              std::vector<SymbolId>& instrument_ids, std::vector<uint32_t>& raw_refs) {
+    SectionReader table(contents.substr(header.symbols_offset));
+    instrument_ids.resize(header.symbol_count);
+    for (uint32_t id = 0; id < header.symbol_count; ++id) {
+        int64_t tick_units = table.read<int64_t>();
+        int32_t tick_decimals = table.read<int32_t>();
+        std::string_view name = table.read_text();
+        if (tick_units <= 0 || tick_decimals < 0 || tick_decimals > 18) {
+            throw std::runtime_error("Invalid binary file: invalid tick size");
+        }
+        symbols.set_tick_size(name, TickSize(tick_units, tick_decimals));
+        instrument_ids[id] = symbols.intern(name);
+    }
+
+    raw_refs.assign(std::max<uint32_t>(header.raw_field_count, 1), 0);
+    for (uint32_t ref = 1; ref < header.raw_field_count; ++ref) {
+        std::string_view side = table.read_text();
+        std::string_view type = table.read_text();
+        std::string_view action = table.read_text();
+        raw_refs[ref] = symbols.store_raw_fields(side, type, action);
+    }
+}
+
+void BinaryFormat::write_placeholder(BufferedWriter& file) {
+    BinaryFileHeader header = {};
+    write_value(file, header);
+}
+
+void BinaryFormat::write_table_and_header(BufferedWriter& file, const SymbolTable& symbols, const char (&magic)[8],
+                                          uint32_t version, uint32_t record_size, uint64_t record_count) {
+    for (size_t id = 0; id < symbols.size(); ++id) {
+        const TickSize& tick = symbols.tick_size(static_cast<SymbolId>(id));
+        write_value(file, static_cast<int64_t>(tick.units));
+        write_value(file, static_cast<int32_t>(tick.decimals));
+        write_text(file, symbols.name(static_cast<SymbolId>(id)));
+    }
+    for (size_t ref = 1; ref < symbols.raw_fields_count(); ++ref) {
+        const RawFields& raw = symbols.get_raw_fields(static_cast<uint32_t>(ref));
+        write_text(file, raw.side);
+        write_text(file, raw.type);
+        write_text(file, raw.action);
+    }
+
+    BinaryFileHeader header = {};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.record_size = record_size;
+    header.record_count = record_count;
+    header.records_offset = sizeof(header);
+    header.symbols_offset = sizeof(header) + record_count * record_size;
+    header.symbol_count = static_cast<uint32_t>(symbols.size());
+    header.raw_field_count = static_cast<uint32_t>(symbols.raw_fields_count());
+    file.write_at(0, std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+}
+
+#endif // BINARY_FORMAT_H
@@ -0,0 +1,169 @@
+#ifndef BINARY_ORDERS_H
+#define BINARY_ORDERS_H
+
+#include "Order.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include "CSVParser.h"
+#include "MappedFile.h"
+#include "BufferedWriter.h"
+#include "BinaryFormat.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// Fichier d'ordres binaire (voir BinaryFormat.h) : ordres déjà parsés et validés (voir csv2bin),
+// relus sans parsing. Les prix sont en ticks de la taille de tick de l'instrument dans la table du fichier.
+
+// Enregistrement d'un ordre : champs de Order à position fixe
+struct OrderRecord {
+    uint64_t timestamp;
+    uint64_t order_id;
+    uint64_t quantity;
+    int64_t price;              // En ticks de l'instrument
+    uint32_t instrument;        // Identifiant dans la table du fichier
+    uint32_t raw_text;          // Référence des textes bruts (0 = aucun)
+    uint8_t side;
+    uint8_t type;
+    uint8_t action;
+    uint8_t status;
+    uint8_t reserved[4];
+};
+
+static_assert(sizeof(OrderRecord) == 48, "OrderRecord layout is part of the file format");
+
+// Lecture d'un fichier d'ordres binaire
+class BinaryOrderFile {
+public:
+    static constexpr char magic[8] = {'M', 'E', 'O', 'R', 'D', 'E', 'R', 'S'};
+    static constexpr uint32_t version = 1;
+
+    static bool is_binary(std::string_view contents) { return BinaryFormat::has_magic(contents, magic); }
+
+    // Lit un fichier d'ordres : binaire s'il commence par l'en-tête binaire, CSV sinon (parse_threads
+    // ne concerne que le CSV). "-" désigne l'entrée standard. Retourne false si le fichier ne peut pas être ouvert.
+    template <typename Callback>
+    static bool for_each_order(const std::string& filename, SymbolTable& symbols, Callback on_order,
+                               size_t parse_threads = 1);
+
+    // Charge la table du fichier dans `symbols` (instruments, tailles de tick et textes bruts, ajoutés
+    // à la suite des existants) puis appelle `on_order` pour chaque enregistrement.
+    // std::runtime_error si le contenu n'est pas un fichier binaire valide.
+    template <typename Callback>
+    static void for_each_order_in(std::string_view contents, SymbolTable& symbols, Callback on_order);
+};
+
+// Écriture d'un fichier d'ordres binaire, en flux : l'en-tête est complété à la fermeture
+class BinaryOrderWriter {
+private:
+    BufferedWriter file;
+    uint64_t order_count;
+
+public:
+    BinaryOrderWriter() : order_count(0) {}
+
+    bool open(const std::string& filename);
+    void write(const Order& order);
+    // Écrit la table des instruments (tous les identifiants référencés doivent y figurer) et l'en-tête
+    void close(const SymbolTable& symbols);
+
+    uint64_t count() const { return order_count; }
+};
+
+// Implémentation
+
+template <typename Callback>
+bool BinaryOrderFile::for_each_order(const std::string& filename, SymbolTable& symbols, Callback on_order,
+                                     size_t parse_threads) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Could not open input file: " << filename << std::endl;
+        return false;
+    }
+
+    if (file.is_stream()) {
+        // La table est en fin de fichier : un fichier binaire en flux est lu en entier
+        if (!is_binary(file.peek(sizeof(magic)))) {
+            CSVParser::for_each_order_streamed(file, symbols, on_order, parse_threads);
+            return true;
+        }
+        file.load();
+    }
+
+    if (is_binary(file.contents())) {
+        for_each_order_in(file.contents(), symbols, on_order);
+    } else {
+        CSVParser::for_each_order_in(file.contents(), symbols, on_order, parse_threads);
+    }
+    return true;
+}
+
+template <typename Callback>
+void BinaryOrderFile::for_each_order_in(std::string_view contents, SymbolTable& symbols, Callback on_order) {
+    BinaryFileHeader header = BinaryFormat::read_header(contents, magic, version, sizeof(OrderRecord));
+    // Identifiants du fichier -> identifiants de `symbols`
+    std::vector<SymbolId> instrument_ids;
+    std::vector<uint32_t> raw_refs;
+    BinaryFormat::read_table(contents, header, symbols, instrument_ids, raw_refs);
+
+    const char* records = contents.data() + header.records_offset;
+    for (uint64_t i = 0; i < header.record_count; ++i) {
+        OrderRecord record;
+        std::memcpy(&record, records + i * sizeof(OrderRecord), sizeof(OrderRecord));
+        if (record.instrument >= header.symbol_count ||
+            (record.raw_text != 0 && record.raw_text >= header.raw_field_count)) {
+            throw std::runtime_error("Invalid binary file: unknown table reference");
+        }
+        if (record.side > static_cast<uint8_t>(Side::SELL) || record.type > static_cast<uint8_t>(OrderType::MARKET) ||
+            record.action > static_cast<uint8_t>(Action::CANCEL) || record.status > static_cast<uint8_t>(Status::REJECTED)) {
+            throw std::runtime_error("Invalid binary file: unknown enumeration value");
+        }
+
+        Order order;
+        order.timestamp = record.timestamp;
+        order.order_id = record.order_id;
+        order.quantity = record.quantity;
+        order.price = record.price;
+        order.instrument = instrument_ids[record.instrument];
+        order.raw_text = raw_refs[record.raw_text];
+        order.side = static_cast<Side>(record.side);
+        order.type = static_cast<OrderType>(record.type);
+        order.action = static_cast<Action>(record.action);
+        order.status = static_cast<Status>(record.status);
+        on_order(order);
+    }
+}
+
+bool BinaryOrderWriter::open(const std::string& filename) {
+    order_count = 0;
+    if (!file.open(filename)) return false;
+    BinaryFormat::write_placeholder(file);
+    return true;
+}
+
+void BinaryOrderWriter::write(const Order& order) {
+    OrderRecord record = {};
+    record.timestamp = order.timestamp;
+    record.order_id = order.order_id;
+    record.quantity = order.quantity;
+    record.price = order.price;
+    record.instrument = order.instrument;
+    record.raw_text = order.raw_text;
+    record.side = static_cast<uint8_t>(order.side);
+    record.type = static_cast<uint8_t>(order.type);
+    record.action = static_cast<uint8_t>(order.action);
+    record.status = static_cast<uint8_t>(order.status);
+    file.write(std::string_view(reinterpret_cast<const char*>(&record), sizeof(record)));
+    order_count++;
+}
+
+void BinaryOrderWriter::close(const SymbolTable& symbols) {
+    BinaryFormat::write_table_and_header(file, symbols, BinaryOrderFile::magic, BinaryOrderFile::version,
+                                         sizeof(OrderRecord), order_count);
+    file.close();
+}
+
+#endif // BINARY_ORDERS_H
@@ -0,0 +1,119 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Fichier de sortie écrit par gros blocs : les lignes sont formatées directement dans un tampon
+// réutilisé, vidé par des appels write() de la taille du tampon (pas de flux ni de locale).
+class BufferedWriter {
+private:
+    int fd;
+    std::vector<char> buffer;
+    size_t used;
+
+public:
+    explicit BufferedWriter(size_t capacity = 1 << 20) : fd(-1), buffer(capacity), used(0) {}
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Crée ou tronque le fichier ; retourne false s'il ne peut pas être ouvert
+    bool open(const std::string& filename);
+    bool is_open() const { return fd >= 0; }
+
+    // Zone d'au moins `bytes` octets libres (le tampon est vidé ou agrandi si besoin),
+    // à valider par commit() avec la fin des octets écrits
+    char* reserve(size_t bytes);
+    void commit(char* end) { used = static_cast<size_t>(end - buffer.data()); }
+
+    void write(std::string_view text);
+    // Vide le tampon puis réécrit `text` à la position `offset` du fichier (en-tête complété après coup)
+    void write_at(uint64_t offset, std::string_view text);
+
+    // Écrit le contenu du tampon dans le fichier ; std::runtime_error en cas d'échec
+    void flush();
+    void close();
+};
+
+// Implémentation
+
+BufferedWriter::~BufferedWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Pas d'exception dans un destructeur : appeler close() pour connaître l'erreur
+    }
+}
+
+bool BufferedWriter::open(const std::string& filename) {
+    close();
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    return fd >= 0;
+}
+
+char* BufferedWriter::reserve(size_t bytes) {
+    if (buffer.size() - used < bytes) {
+        flush();
+        if (buffer.size() < bytes) buffer.resize(bytes);
+    }
+    return buffer.data() + used;
+}
+
+void BufferedWriter::write(std::string_view text) {
+    char* out = reserve(text.size());
+    std::memcpy(out, text.data(), text.size());
+    commit(out + text.size());
+}
+
+void BufferedWriter::write_at(uint64_t offset, std::string_view text) {
+    flush();
+    while (!text.empty()) {
+        ssize_t written = ::pwrite(fd, text.data(), text.size(), static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Could not write output file: ") + std::strerror(errno));
+        }
+        text.remove_prefix(static_cast<size_t>(written));
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+void BufferedWriter::flush() {
+    const char* data = buffer.data();
+    size_t remaining = used;
+    used = 0;
+    while (remaining > 0 && fd >= 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Could not write output file: ") + std::strerror(errno));
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+}
+
+void BufferedWriter::close() {
+    if (fd < 0) return;
+    int closing = fd;
+    try {
+        flush();
+    } catch (...) {
+        ::close(closing);
+        fd = -1;
+        throw;
+    }
+    fd = -1;
+    ::close(closing);
+}
+
+#endif // BUFFERED_WRITER_H
@@ -2,213 +2,596 @@
 #define CSV_PARSER_H
 
 #include "Order.h"
+#include "ExecutionReport.h"
+#include "ResultSink.h"
 #include "Validator.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include "MappedFile.h"
+#include "CSVTokenizer.h"
+#include "BufferedWriter.h"
+#include "ThreadPool.h"
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstring>
+#include <charconv>
 #include <fstream>
-#include <sstream>
 #include <iostream>
-#include <iomanip>
-#include <unordered_set>
+#include <stdexcept>
+#include <deque>
+#include <memory>
+#include <future>
+#include <exception>
 
 // Classe utilitaire pour gérer les fichiers CSV
 class CSVParser {
 public:
-    static std::vector<Order> parse_input_file(const std::string& filename);
-    static void write_output_file(const std::string& filename, const std::vector<Order>& orders);
+    // Les instruments sont internés dans `symbols`, qui porte aussi leur taille de tick
+    static std::vector<Order> parse_input_file(const std::string& filename, SymbolTable& symbols);
+    // Lecture en flux : appelle `on_order(order)` pour chaque ordre lu, sans tout garder en mémoire.
+    // Le fichier est projeté en mémoire et découpé sur place ; "-", un tube ou une FIFO sont lus par blocs
+    // (voir for_each_order_streamed). Retourne false s'il ne peut pas être ouvert.
+    // Avec parse_threads > 1, les lignes sont parsées par blocs en parallèle (voir for_each_order_in).
+    template <typename Callback>
+    static bool for_each_order(const std::string& filename, SymbolTable& symbols, Callback on_order,
+                               size_t parse_threads = 1);
+
+    // Même lecture sur un contenu déjà en mémoire (la première ligne est l'en-tête).
+    // En parallèle, le texte est découpé en blocs d'environ `chunk_bytes` aux fins de ligne ; les blocs sont
+    // parsés et validés sur un pool de threads puis remis dans l'ordre du fichier, où sont faits l'internement
+    // des instruments et l'affichage des avertissements (numéros de ligne exacts).
+    // Les ordres transmis sont identiques à ceux de la lecture séquentielle.
+    template <typename Callback>
+    static void for_each_order_in(std::string_view text, SymbolTable& symbols, Callback on_order,
+                                  size_t parse_threads = 1, size_t chunk_bytes = 1 << 20);
+
+    // Même lecture sur une source en flux (MappedFile::is_stream) : seule la ligne en cours de lecture
+    // est gardée d'un bloc à l'autre. En séquentiel, les lignes sont parsées dès qu'elles arrivent ;
+    // en parallèle, par blocs d'au moins `block_bytes` (débit plutôt que latence).
+    template <typename Callback>
+    static void for_each_order_streamed(MappedFile& file, SymbolTable& symbols, Callback on_order,
+                                        size_t parse_threads = 1, size_t block_bytes = 1 << 22);
+
+    static void write_output_file(const std::string& filename, const std::vector<ExecutionReport>& reports,
+                                  const SymbolTable& symbols);
+    // Écriture d'une ligne de sortie (utilisée aussi par CSVSink)
+    static void write_header(BufferedWriter& out);
+    static void write_report(BufferedWriter& out, const ExecutionReport& report, const SymbolTable& symbols);
 
 private:
-    static Order parse_order_line(const std::string& line, int line_number);
-    static std::vector<std::string> split_csv_line(const std::string& line);
-    static std::string trim(const std::string& str);
+    // Avertissement de parsing d'une ligne, différé en lecture parallèle
+    struct LineDiagnostic {
+        int line_number;        // Relatif au début du bloc en lecture parallèle
+        size_t field_count;     // Nombre de champs incorrect (si `error` est vide)
+        std::string error;      // Message de l'exception de conversion
+    };
+
+    // Bloc de lignes parsé par un worker, avec sa copie de la table des instruments
+    struct ParsedChunk {
+        std::vector<Order> orders;
+        std::vector<LineDiagnostic> diagnostics;
+        SymbolTable symbols;
+        int line_count = 0;
+        std::exception_ptr failure;     // Exception hors validation : arrête la lecture à cette ligne
+        std::promise<void> done;
+    };
+
+    // Lecture commencée : lignes déjà lues (la ligne 1 est l'en-tête)
+    struct ReadState {
+        int line_number = 0;
+        bool zero_id_seen = false;  // Ordre NEW valide d'ID 0 déjà lu (voir accept_order)
+    };
+
+    // Lecture parallèle : pool et copie des instruments, gardés d'un bloc à l'autre d'une lecture en flux
+    // (la copie n'est refaite que si des instruments ont été ajoutés depuis)
+    struct ParallelReader {
+        WorkStealingPool pool;
+        SymbolTable snapshot;
+        bool has_snapshot = false;
+
+        explicit ParallelReader(size_t parse_threads) : pool(parse_threads) {}
+    };
+
+    // Parse les lignes de `text`, à la suite de celles de `state`
+    template <typename Callback>
+    static void parse_lines(std::string_view text, ReadState& state, SymbolTable& symbols, Callback& on_order);
+    template <typename Callback>
+    static void parse_in_parallel(std::string_view text, ReadState& state, SymbolTable& symbols,
+                                  Callback& on_order, ParallelReader& reader, size_t chunk_bytes);
+    static void parse_chunk(std::string_view text, ParsedChunk& chunk);
+    // Replace les identifiants d'instrument et les textes bruts d'un ordre du bloc dans `symbols`
+    static void import_order(Order& order, ParsedChunk& chunk, size_t snapshot_size,
+                             std::vector<SymbolId>& imported_ids, SymbolTable& symbols);
+    // Retourne true si l'ordre doit être transmis. Les doublons d'ID sont détectés par le moteur (index
+    // des ordres), sauf pour l'ID 0 : un ordre valide d'ID 0 n'est pas transmis, ses doublons NEW le sont
+    // comme rejetés.
+    static bool accept_order(Order& order, ReadState& state);
+    static void print_diagnostic(const LineDiagnostic& diagnostic, int first_line);
+
+    // Les champs viennent de CSVTokenizer. Les avertissements sont affichés, ou ajoutés à `deferred` s'il est fourni
+    static Order parse_order_line(const LineFields& fields, int line_number, SymbolTable& symbols,
+                                  std::vector<LineDiagnostic>* deferred = nullptr);
+    static void set_text_fields(Order& order, std::string_view side, std::string_view type,
+                                std::string_view action, SymbolTable& symbols);
+    // Comme set_text_fields sans tenir compte de la casse ; les textes bruts sont conservés en majuscules
+    static void set_text_fields_upper(Order& order, std::string_view side, std::string_view type,
+                                      std::string_view action, SymbolTable& symbols);
+    static std::string_view trim(std::string_view str);
+    static bool is_trimmed(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+    // Convertit un entier validé par Validator::is_valid_integer comme std::stoull
+    // (un signe '-' donne le complément modulo 2^64 ; std::out_of_range en cas de dépassement)
+    static uint64_t to_uint64(std::string_view str);
+};
+
+// Écrit les événements du moteur dans un fichier CSV au fil de l'eau (par blocs, voir BufferedWriter)
+class CSVSink : public ResultSink {
+private:
+    BufferedWriter file;
+    const SymbolTable& symbols;
+    uint64_t rows;
+
+public:
+    CSVSink(const std::string& filename, const SymbolTable& symbol_table)
+        : symbols(symbol_table), rows(0) {
+        if (file.open(filename)) {
+            CSVParser::write_header(file);
+        }
+    }
+
+    bool is_open() const { return file.is_open(); }
+    uint64_t row_count() const { return rows; }
+
+    void on_report(const ExecutionReport& report) override {
+        CSVParser::write_report(file, report, symbols);
+        rows++;
+    }
+
+    void flush() override { file.flush(); }
 };
 
 // Lecture du fichier CSV d'entrée
-std::vector<Order> CSVParser::parse_input_file(const std::string& filename) {
+std::vector<Order> CSVParser::parse_input_file(const std::string& filename, SymbolTable& symbols) {
     std::vector<Order> orders;
-    std::ifstream file(filename);
-    std::string line;
-    int line_number = 0;
-    std::unordered_set<uint64_t> seen_order_ids; // Pour vérifier les doublons d'order_id
+    for_each_order(filename, symbols, [&orders](const Order& order) {
+        orders.push_back(order);
+    });
+    return orders;
+}
 
-    if (!file.is_open()) {
+template <typename Callback>
+bool CSVParser::for_each_order(const std::string& filename, SymbolTable& symbols, Callback on_order,
+                               size_t parse_threads) {
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Error: Could not open input file: " << filename << std::endl;
-        return orders;
+        return false;
+    }
+
+    if (file.is_stream()) {
+        for_each_order_streamed(file, symbols, on_order, parse_threads);
+    } else {
+        for_each_order_in(file.contents(), symbols, on_order, parse_threads);
+    }
+    return true;
+}
+
+template <typename Callback>
+void CSVParser::for_each_order_in(std::string_view text, SymbolTable& symbols, Callback on_order,
+                                  size_t parse_threads, size_t chunk_bytes) {
+    ReadState state;
+    if (parse_threads > 1) {
+        ParallelReader reader(parse_threads);
+        parse_in_parallel(text, state, symbols, on_order, reader, chunk_bytes);
+    } else {
+        parse_lines(text, state, symbols, on_order);
     }
+}
 
-    // Sauter l'en-tête
-    if (std::getline(file, line)) {
-        line_number++;
+template <typename Callback>
+void CSVParser::for_each_order_streamed(MappedFile& file, SymbolTable& symbols, Callback on_order,
+                                        size_t parse_threads, size_t block_bytes) {
+    ReadState state;
+    std::unique_ptr<ParallelReader> reader;
+    if (parse_threads > 1) reader.reset(new ParallelReader(parse_threads));
+    std::vector<char> block(block_bytes);
+    size_t filled = 0;
+    bool end = false;
+    while (!end) {
+        size_t count = file.read(block.data() + filled, block.size() - filled);
+        filled += count;
+        end = count == 0;
+        if (!end && parse_threads > 1 && filled < block.size()) continue;
+
+        // Lignes complètes du bloc ; la ligne coupée par la fin du bloc est reportée au suivant
+        std::string_view text(block.data(), filled);
+        size_t complete = filled;
+        if (!end) {
+            size_t newline = text.rfind('\n');
+            if (newline == std::string_view::npos) {
+                // Ligne plus longue que le bloc
+                if (filled == block.size()) block.resize(2 * block.size());
+                continue;
+            }
+            complete = newline + 1;
+        }
+        if (parse_threads > 1) {
+            parse_in_parallel(text.substr(0, complete), state, symbols, on_order, *reader, 1 << 20);
+        } else {
+            parse_lines(text.substr(0, complete), state, symbols, on_order);
+        }
+        std::memmove(block.data(), block.data() + complete, filled - complete);
+        filled -= complete;
     }
+}
+
+template <typename Callback>
+void CSVParser::parse_lines(std::string_view text, ReadState& state, SymbolTable& symbols, Callback& on_order) {
+    // Lignes et champs découpés par blocs (la dernière ligne peut ne pas avoir de '\n')
+    CSVTokenizer tokenizer(text);
+    std::string_view line;
+    LineFields fields;
+    while (tokenizer.next_line(line, fields)) {
+        // Sauter l'en-tête
+        state.line_number++;
+        if (state.line_number == 1) {
+            continue;
+        }
 
-    while (std::getline(file, line)) {
-        line_number++;
         if (line.empty() || std::all_of(line.begin(), line.end(), ::isspace)) {
             continue;
         }
 
-        Order order = parse_order_line(line, line_number);
+        Order order = parse_order_line(fields, state.line_number, symbols);
+        if (accept_order(order, state)) {
+            on_order(order);
+        }
+    }
+}
+
+template <typename Callback>
+void CSVParser::parse_in_parallel(std::string_view text, ReadState& state, SymbolTable& symbols,
+                                  Callback& on_order, ParallelReader& reader, size_t chunk_bytes) {
+    // L'en-tête (ligne 1) est lu ici ; les blocs commencent à la ligne suivante
+    size_t position = 0;
+    if (state.line_number == 0) {
+        size_t header_end = text.find('\n');
+        if (header_end == std::string_view::npos) return;
+        position = header_end + 1;
+        state.line_number = 1;
+    }
+    int first_line = state.line_number + 1;
+
+    if (!reader.has_snapshot || reader.snapshot.size() != symbols.size()) {
+        reader.snapshot = symbols.snapshot_instruments();
+        reader.has_snapshot = true;
+    }
+    const SymbolTable& snapshot = reader.snapshot;
+    const size_t snapshot_size = snapshot.size();
+    std::vector<SymbolId> imported_ids;
+
+    // Au plus deux blocs par thread en cours : la mémoire reste bornée
+    std::deque<std::shared_ptr<ParsedChunk>> in_flight;
+    WorkStealingPool& pool = reader.pool;
+    const size_t parse_threads = pool.thread_count();
+    // Le pool survit à l'appel (blocs suivants d'un flux) : sur erreur, les blocs encore en cours
+    // sont attendus avant que le texte qu'ils lisent ne soit libéré
+    try {
+        while (position < text.size() || !in_flight.empty()) {
+            while (position < text.size() && in_flight.size() < 2 * parse_threads) {
+                // Bloc coupé après une fin de ligne
+                size_t end = std::min(text.size(), position + chunk_bytes);
+                if (end < text.size()) {
+                    size_t newline = text.find('\n', end - 1);
+                    end = (newline == std::string_view::npos) ? text.size() : newline + 1;
+                }
+                std::string_view block = text.substr(position, end - position);
+                position = end;
+
+                auto chunk = std::make_shared<ParsedChunk>();
+                chunk->symbols = snapshot.snapshot_instruments();
+                in_flight.push_back(chunk);
+                pool.submit([block, chunk]() { parse_chunk(block, *chunk); });
+            }
+
+            // Remise dans l'ordre : le plus ancien bloc d'abord
+            std::shared_ptr<ParsedChunk> chunk = in_flight.front();
+            in_flight.pop_front();
+            chunk->done.get_future().wait();
 
-        // Vérifie les doublons sur les ordres "NEW"
-        if (order.status != "REJECTED" && order.action == "NEW") {
-            if (seen_order_ids.find(order.order_id) != seen_order_ids.end()) {
-                order.status = "REJECTED";
-            } else {
-                seen_order_ids.insert(order.order_id);
+            for (const LineDiagnostic& diagnostic : chunk->diagnostics) {
+                print_diagnostic(diagnostic, first_line);
             }
+            imported_ids.assign(chunk->symbols.size(), 0);
+            for (Order& order : chunk->orders) {
+                import_order(order, *chunk, snapshot_size, imported_ids, symbols);
+                if (accept_order(order, state)) {
+                    on_order(order);
+                }
+            }
+            if (chunk->failure) {
+                std::rethrow_exception(chunk->failure);
+            }
+            first_line += chunk->line_count;
+            state.line_number = first_line - 1;
         }
+    } catch (...) {
+        pool.wait();
+        throw;
+    }
+}
 
-        // Ajoute l'ordre à la liste si valide
-        if (order.order_id != 0 || order.status == "REJECTED") {
-            orders.push_back(order);
+// Parse un bloc de lignes complètes (numéros de ligne relatifs au bloc)
+void CSVParser::parse_chunk(std::string_view text, ParsedChunk& chunk) {
+    chunk.orders.reserve(text.size() / 48);
+    CSVTokenizer tokenizer(text);
+    std::string_view line;
+    LineFields fields;
+    try {
+        while (tokenizer.next_line(line, fields)) {
+            chunk.line_count++;
+
+            if (line.empty() || std::all_of(line.begin(), line.end(), ::isspace)) {
+                continue;
+            }
+            chunk.orders.push_back(parse_order_line(fields, chunk.line_count - 1, chunk.symbols, &chunk.diagnostics));
         }
+    } catch (...) {
+        chunk.failure = std::current_exception();
     }
+    chunk.done.set_value();
+}
 
-    file.close();
-    return orders;
+void CSVParser::import_order(Order& order, ParsedChunk& chunk, size_t snapshot_size,
+                             std::vector<SymbolId>& imported_ids, SymbolTable& symbols) {
+    // Instruments connus avant la lecture : même identifiant ; sinon interné au premier usage
+    if (order.instrument >= snapshot_size) {
+        SymbolId& imported = imported_ids[order.instrument];
+        if (imported == 0) imported = symbols.intern(chunk.symbols.name(order.instrument));
+        order.instrument = imported;
+    }
+    if (order.raw_text != 0) {
+        const RawFields& raw = chunk.symbols.get_raw_fields(order.raw_text);
+        order.raw_text = symbols.store_raw_fields(raw.side, raw.type, raw.action);
+    }
+}
+
+bool CSVParser::accept_order(Order& order, ReadState& state) {
+    if (order.order_id == 0 && order.status != Status::REJECTED && order.action == Action::NEW) {
+        if (state.zero_id_seen) order.status = Status::REJECTED;
+        state.zero_id_seen = true;
+    }
+
+    // Transmet l'ordre si valide
+    return order.order_id != 0 || order.status == Status::REJECTED;
+}
+
+void CSVParser::print_diagnostic(const LineDiagnostic& diagnostic, int first_line) {
+    int line_number = first_line + diagnostic.line_number;
+    if (diagnostic.error.empty()) {
+        std::cerr << "Warning: Line " << line_number << " has " << diagnostic.field_count
+                  << " fields instead of 8, rejecting order" << std::endl;
+    } else {
+        std::cerr << "Error parsing line " << line_number << ": " << diagnostic.error << std::endl;
+    }
 }
 
 // Écriture du fichier CSV de sortie
-void CSVParser::write_output_file(const std::string& filename, const std::vector<Order>& orders) {
-    std::ofstream file(filename);
+void CSVParser::write_output_file(const std::string& filename, const std::vector<ExecutionReport>& reports,
+                                  const SymbolTable& symbols) {
+    BufferedWriter file;
 
-    if (!file.is_open()) {
+    if (!file.open(filename)) {
         std::cerr << "Error: Could not open output file: " << filename << std::endl;
         return;
     }
 
-    // Écrit l'en-tête
-    file << "timestamp,order_id,instrument,side,type,quantity,price,action,"
-         << "status,executed_quantity,execution_price,counterparty_id\n";
-
-    // Écrit les ordres
-    for (const auto& order : orders) {
-        file << order.timestamp << ","
-             << order.order_id << ","
-             << order.instrument << ","
-             << order.side << ","
-             << order.type << ","
-             << order.quantity << ","
-             << std::fixed << std::setprecision(2) << order.price << ","
-             << order.action << ","
-             << order.status << ","
-             << order.executed_quantity << ","
-             << std::fixed << std::setprecision(2) << order.execution_price << ","
-             << order.counterparty_id << "\n";
+    write_header(file);
+    for (const auto& report : reports) {
+        write_report(file, report, symbols);
     }
 
     file.close();
 }
 
+void CSVParser::write_header(BufferedWriter& out) {
+    out.write("timestamp,order_id,instrument,side,type,quantity,price,action,"
+              "status,executed_quantity,execution_price,counterparty_id\n");
+}
+
+void CSVParser::write_report(BufferedWriter& out, const ExecutionReport& report, const SymbolTable& symbols) {
+    const TickSize& tick = symbols.tick_size(report.instrument);
+    std::string_view side = to_string(report.side);
+    std::string_view type = to_string(report.type);
+    std::string_view action = to_string(report.action);
+    std::string_view status = to_string(report.status);
+    std::string_view instrument = symbols.name(report.instrument);
+    uint64_t counterparty_id = report.counterparty_id;
+    // Textes d'origine pour un ordre rejeté aux champs non canoniques
+    if (report.status == Status::REJECTED) {
+        if (report.raw_text != 0) {
+            const RawFields& raw = symbols.get_raw_fields(static_cast<uint32_t>(report.raw_text));
+            side = raw.side;
+            type = raw.type;
+            action = raw.action;
+        }
+        counterparty_id = 0;
+    }
+
+    // Taille maximale de la ligne : 5 entiers de 20 chiffres, 2 prix et 12 séparateurs
+    size_t bound = 5 * 20 + 2 * TickSize::max_formatted_size + 12 +
+                   instrument.size() + side.size() + type.size() + action.size() + status.size();
+    char* cursor = out.reserve(bound);
+    auto put_text = [&cursor](std::string_view text) {
+        std::memcpy(cursor, text.data(), text.size());
+        cursor += text.size();
+        *cursor++ = ',';
+    };
+    auto put_integer = [&cursor](uint64_t value) {
+        cursor = std::to_chars(cursor, cursor + 20, value).ptr;
+        *cursor++ = ',';
+    };
+
+    put_integer(report.timestamp);
+    put_integer(report.order_id);
+    put_text(instrument);
+    put_text(side);
+    put_text(type);
+    put_integer(report.quantity);
+    cursor = tick.format(cursor, report.price);
+    *cursor++ = ',';
+    put_text(action);
+    put_text(status);
+    put_integer(report.executed_quantity);
+    cursor = tick.format(cursor, report.execution_price);
+    *cursor++ = ',';
+    put_integer(counterparty_id);
+    cursor[-1] = '\n';
+    out.commit(cursor);
+}
+
 // Parse une ligne CSV en Order
-Order CSVParser::parse_order_line(const std::string& line, int line_number) {
+Order CSVParser::parse_order_line(const LineFields& fields, int line_number, SymbolTable& symbols,
+                                  std::vector<LineDiagnostic>* deferred) {
     Order order;
-    std::vector<std::string> fields = split_csv_line(line);
+    // Champs texte avant conversion (vues sur la ligne)
+    std::string_view instrument, side, type, action;
 
     // Vérifie que la ligne a le bon nombre de champs
-    if (fields.size() != 8) {
-        std::cerr << "Warning: Line " << line_number << " has " << fields.size() 
-                  << " fields instead of 8, rejecting order" << std::endl;
+    if (fields.count != 8) {
+        LineDiagnostic diagnostic{line_number, fields.count, std::string()};
+        if (deferred) deferred->push_back(diagnostic);
+        else print_diagnostic(diagnostic, 0);
 
         // Tente de récupérer partiellement les champs pour un ordre rejeté
-        if (fields.size() >= 2) {
+        if (fields.count >= 2) {
             if (Validator::is_valid_integer(fields[0])) {
-                order.timestamp = std::stoull(fields[0]);
+                order.timestamp = to_uint64(fields[0]);
             }
             if (Validator::is_valid_integer(fields[1])) {
-                order.order_id = std::stoull(fields[1]);
+                order.order_id = to_uint64(fields[1]);
             }
         }
-        if (fields.size() >= 3) order.instrument = trim(fields[2]);
-        if (fields.size() >= 4) order.side = trim(fields[3]);
-        if (fields.size() >= 5) order.type = trim(fields[4]);
-        if (fields.size() >= 6 && Validator::is_valid_integer(fields[5])) {
-            order.quantity = std::stoull(fields[5]);
+        if (fields.count >= 3) instrument = trim(fields[2]);
+        order.instrument = symbols.intern(instrument);
+        if (fields.count >= 4) side = trim(fields[3]);
+        if (fields.count >= 5) type = trim(fields[4]);
+        if (fields.count >= 6 && Validator::is_valid_integer(fields[5])) {
+            order.quantity = to_uint64(fields[5]);
         }
-        if (fields.size() >= 7 && Validator::is_valid_number(fields[6])) {
-            order.price = std::stod(fields[6]);
+        if (fields.count >= 7 && Validator::is_valid_number(fields[6])) {
+            symbols.tick_size(order.instrument).to_ticks(fields[6], order.price);
         }
-        if (fields.size() >= 8) order.action = trim(fields[7]);
+        if (fields.count >= 8) action = trim(fields[7]);
 
-        order.status = "REJECTED";
+        set_text_fields(order, side, type, action, symbols);
+        order.status = Status::REJECTED;
         return order;
     }
 
     try {
         // Validation des champs principaux
         if (!Validator::is_valid_integer(trim(fields[0]))) {
-            order.status = "REJECTED";
+            order.status = Status::REJECTED;
             return order;
         }
-        order.timestamp = std::stoull(trim(fields[0]));
+        order.timestamp = to_uint64(trim(fields[0]));
 
         if (!Validator::is_valid_integer(trim(fields[1]))) {
-            order.status = "REJECTED";
+            order.status = Status::REJECTED;
             return order;
         }
-        order.order_id = std::stoull(trim(fields[1]));
+        order.order_id = to_uint64(trim(fields[1]));
 
-        order.instrument = trim(fields[2]);
-        order.side = Validator::to_upper(trim(fields[3]));
-        order.type = Validator::to_upper(trim(fields[4]));
+        instrument = trim(fields[2]);
+        order.instrument = symbols.intern(instrument);
+        side = trim(fields[3]);
+        type = trim(fields[4]);
 
-        std::string qty_str = trim(fields[5]);
+        std::string_view qty_str = trim(fields[5]);
         if (!Validator::is_valid_integer(qty_str) || qty_str[0] == '-') {
-            order.status = "REJECTED";
             order.quantity = 0;
-            order.instrument = trim(fields[2]);
-            order.side = Validator::to_upper(trim(fields[3]));
-            order.type = Validator::to_upper(trim(fields[4]));
-            order.action = Validator::to_upper(trim(fields[7]));
+            set_text_fields_upper(order, side, type, trim(fields[7]), symbols);
+            order.status = Status::REJECTED;
             return order;
         }
-        order.quantity = std::stoull(qty_str);
-
-        std::string price_str = trim(fields[6]);
-        if (!Validator::is_valid_number(price_str)) {
-            order.status = "REJECTED";
+        order.quantity = to_uint64(qty_str);
+
+        // Conversion du prix en ticks de l'instrument
+        std::string_view price_str = trim(fields[6]);
+        if (!Validator::is_valid_number(price_str) ||
+            !symbols.tick_size(order.instrument).to_ticks(price_str, order.price)) {
+            set_text_fields_upper(order, side, type, action, symbols);
+            order.status = Status::REJECTED;
             return order;
         }
-        order.price = std::stod(price_str);
 
-        order.action = Validator::to_upper(trim(fields[7]));
+        action = trim(fields[7]);
+        set_text_fields_upper(order, side, type, action, symbols);
 
         // Validation finale de l'ordre
-        Validator::ValidationResult validation = Validator::validate_order(order);
+        Validator::ValidationResult validation =
+            Validator::validate_order(instrument, side, type, action, order.quantity, order.price);
         if (validation != Validator::ValidationResult::VALID) {
-            order.status = "REJECTED";
+            order.status = Status::REJECTED;
             return order;
         }
 
     } catch (const std::exception& e) {
-        std::cerr << "Error parsing line " << line_number << ": " << e.what() << std::endl;
-        order.status = "REJECTED";
+        LineDiagnostic diagnostic{line_number, fields.count, e.what()};
+        if (deferred) deferred->push_back(diagnostic);
+        else print_diagnostic(diagnostic, 0);
+        set_text_fields_upper(order, side, type, action, symbols);
+        order.status = Status::REJECTED;
         return order;
     }
 
     return order;
 }
 
-// Découpe une ligne CSV en champs
-std::vector<std::string> CSVParser::split_csv_line(const std::string& line) {
-    std::vector<std::string> fields;
-    std::stringstream ss(line);
-    std::string field;
-
-    while (std::getline(ss, field, ',')) {
-        fields.push_back(field);
+// Convertit side/type/action en énumérations ; les textes non canoniques sont conservés pour la sortie
+void CSVParser::set_text_fields(Order& order, std::string_view side, std::string_view type,
+                                std::string_view action, SymbolTable& symbols) {
+    bool canonical_side = parse_side(side, order.side);
+    bool canonical_type = parse_order_type(type, order.type);
+    bool canonical_action = parse_action(action, order.action);
+    if (!canonical_side || !canonical_type || !canonical_action) {
+        order.raw_text = symbols.store_raw_fields(side, type, action);
     }
+}
 
-    return fields;
+void CSVParser::set_text_fields_upper(Order& order, std::string_view side, std::string_view type,
+                                      std::string_view action, SymbolTable& symbols) {
+    bool known_side = side.empty() || Validator::match_side(side, order.side);
+    bool known_type = type.empty() || Validator::match_order_type(type, order.type);
+    bool known_action = action.empty() || Validator::match_action(action, order.action);
+    if (!known_side || !known_type || !known_action) {
+        order.raw_text = symbols.store_raw_fields(Validator::to_upper(side), Validator::to_upper(type),
+                                                  Validator::to_upper(action));
+    }
 }
 
 // Supprime les espaces en début et fin de chaîne
-std::string CSVParser::trim(const std::string& str) {
-    size_t start = str.find_first_not_of(" \t\r\n");
-    if (start == std::string::npos) return "";
+std::string_view CSVParser::trim(std::string_view str) {
+    size_t start = 0;
+    size_t end = str.size();
+    while (start < end && is_trimmed(str[start])) start++;
+    while (end > start && is_trimmed(str[end - 1])) end--;
+    return str.substr(start, end - start);
+}
 
-    size_t end = str.find_last_not_of(" \t\r\n");
-    return str.substr(start, end - start + 1);
+uint64_t CSVParser::to_uint64(std::string_view str) {
+    bool negative = (str[0] == '-');
+    size_t i = (str[0] == '-' || str[0] == '+') ? 1 : 0;
+    uint64_t value = 0;
+    for (; i < str.size(); ++i) {
+        uint64_t digit = static_cast<uint64_t>(str[i] - '0');
+        if (value > (UINT64_MAX - digit) / 10) {
+            throw std::out_of_range("stoull");
+        }
+        value = value * 10 + digit;
+    }
+    return negative ? (0 - value) : value;
 }
 
 #endif // CSV_PARSER_H
\ No newline at end of file
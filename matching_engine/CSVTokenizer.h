@@ -0,0 +1,199 @@
+#ifndef CSV_TOKENIZER_H
+#define CSV_TOKENIZER_H
+
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CSV_TOKENIZER_X86 1
+#endif
+
+// Champs d'une ligne, vues sur le texte d'entrée : seuls les 8 premiers sont conservés,
+// `count` compte tous les champs de la ligne (une virgule finale n'ouvre pas de champ vide)
+struct LineFields {
+    std::string_view fields[8];
+    size_t count;
+
+    std::string_view operator[](size_t index) const { return fields[index]; }
+};
+
+// Découpage d'un texte CSV en lignes et champs. Les positions des virgules et fins de ligne sont
+// relevées par blocs de texte, 16 (SSE2) ou 32 (AVX2) octets à la fois, puis les lignes sont lues
+// dans ces positions sans relire les caractères. Le jeu d'instructions est vérifié à l'exécution :
+// SSE2 par défaut, AVX2 sur demande (set_prefer_avx2), son gain dépendant du processeur.
+class CSVTokenizer {
+public:
+    enum class ScanPath { SCALAR, SSE2, AVX2 };
+
+    // Chemin utilisable sur le processeur courant
+    static bool is_supported(ScanPath path);
+    // Chemin par défaut : SSE2, ou AVX2 s'il a été demandé et est disponible. Sur des lignes CSV courtes,
+    // le relevé de 32 octets n'est pas toujours plus rapide (make bench compare les chemins).
+    static ScanPath default_path();
+    // Demande le chemin AVX2 (avant toute lecture)
+    static void set_prefer_avx2(bool prefer) { prefer_avx2() = prefer; }
+    static const char* path_name(ScanPath path);
+
+    // Écrit dans `positions` les positions (relatives à `data`) des ',' et '\n' de [data, data + size) ;
+    // `positions` doit pouvoir en contenir `size`. Retourne leur nombre.
+    static size_t scan(ScanPath path, const char* data, size_t size, uint32_t* positions);
+
+    explicit CSVTokenizer(std::string_view text, ScanPath path = default_path(), size_t block_bytes = 1 << 15);
+
+    // Ligne suivante (sans son '\n') et ses champs ; false à la fin du texte
+    bool next_line(std::string_view& line, LineFields& fields);
+
+private:
+    std::string_view text;
+    ScanPath path;
+    size_t block_bytes;
+    std::vector<uint32_t> positions;    // Délimiteurs du bloc courant
+    size_t position_count;
+    size_t cursor;                      // Prochain délimiteur à consommer
+    size_t block_start;
+    size_t scanned;                     // Fin du texte déjà relevé
+    size_t line_start;
+
+    // Relève les délimiteurs du bloc suivant ; false si tout le texte a été relevé
+    bool refill();
+
+    static bool& prefer_avx2() {
+        static bool prefer = false;
+        return prefer;
+    }
+
+    static size_t scan_scalar(const char* data, size_t begin, size_t size, uint32_t* positions, size_t count);
+#ifdef CSV_TOKENIZER_X86
+    static size_t scan_sse2(const char* data, size_t size, uint32_t* positions);
+    __attribute__((target("avx2"))) static size_t scan_avx2(const char* data, size_t size, uint32_t* positions);
+#endif
+};
+
+// Implémentation
+
+bool CSVTokenizer::is_supported(ScanPath path) {
+#ifdef CSV_TOKENIZER_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return path != ScanPath::AVX2 || avx2;
+#else
+    return path == ScanPath::SCALAR;
+#endif
+}
+
+CSVTokenizer::ScanPath CSVTokenizer::default_path() {
+#ifdef CSV_TOKENIZER_X86
+    return (prefer_avx2() && is_supported(ScanPath::AVX2)) ? ScanPath::AVX2 : ScanPath::SSE2;
+#else
+    return ScanPath::SCALAR;
+#endif
+}
+
+const char* CSVTokenizer::path_name(ScanPath path) {
+    switch (path) {
+        case ScanPath::SSE2: return "SSE2";
+        case ScanPath::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+size_t CSVTokenizer::scan(ScanPath path, const char* data, size_t size, uint32_t* positions) {
+#ifdef CSV_TOKENIZER_X86
+    if (path == ScanPath::AVX2) return scan_avx2(data, size, positions);
+    if (path == ScanPath::SSE2) return scan_sse2(data, size, positions);
+#endif
+    (void)path;
+    return scan_scalar(data, 0, size, positions, 0);
+}
+
+size_t CSVTokenizer::scan_scalar(const char* data, size_t begin, size_t size, uint32_t* positions, size_t count) {
+    for (size_t i = begin; i < size; ++i) {
+        if (data[i] == ',' || data[i] == '\n') positions[count++] = static_cast<uint32_t>(i);
+    }
+    return count;
+}
+
+#ifdef CSV_TOKENIZER_X86
+size_t CSVTokenizer::scan_sse2(const char* data, size_t size, uint32_t* positions) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, newline))));
+        while (mask != 0) {
+            positions[count++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+    return scan_scalar(data, i, size, positions, count);
+}
+
+__attribute__((target("avx2")))
+size_t CSVTokenizer::scan_avx2(const char* data, size_t size, uint32_t* positions) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, comma), _mm256_cmpeq_epi8(bytes, newline))));
+        while (mask != 0) {
+            positions[count++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+    return scan_scalar(data, i, size, positions, count);
+}
+#endif
+
+CSVTokenizer::CSVTokenizer(std::string_view input, ScanPath scan_path, size_t block_size)
+    : text(input), path(scan_path), block_bytes(std::min(block_size, input.size())), positions(block_bytes),
+      position_count(0), cursor(0), block_start(0), scanned(0), line_start(0) {}
+
+bool CSVTokenizer::refill() {
+    if (scanned >= text.size()) return false;
+    size_t size = std::min(block_bytes, text.size() - scanned);
+    position_count = scan(path, text.data() + scanned, size, positions.data());
+    cursor = 0;
+    block_start = scanned;
+    scanned += size;
+    return true;
+}
+
+bool CSVTokenizer::next_line(std::string_view& line, LineFields& fields) {
+    if (line_start >= text.size()) return false;
+
+    fields.count = 0;
+    size_t field_start = line_start;
+    size_t line_end = text.size();
+    while (true) {
+        if (cursor == position_count) {
+            if (!refill()) break;
+            continue;
+        }
+        size_t delimiter = block_start + positions[cursor++];
+        if (text[delimiter] == '\n') {
+            line_end = delimiter;
+            break;
+        }
+        if (fields.count < 8) fields.fields[fields.count] = text.substr(field_start, delimiter - field_start);
+        fields.count++;
+        field_start = delimiter + 1;
+    }
+    if (field_start < line_end) {
+        if (fields.count < 8) fields.fields[fields.count] = text.substr(field_start, line_end - field_start);
+        fields.count++;
+    }
+
+    line = text.substr(line_start, line_end - line_start);
+    line_start = line_end + 1;
+    return true;
+}
+
+#endif // CSV_TOKENIZER_H
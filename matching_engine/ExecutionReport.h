@@ -0,0 +1,50 @@
+#ifndef EXECUTION_REPORT_H
+#define EXECUTION_REPORT_H
+
+#include "Order.h"
+
+// Événement émis par le carnet (accusé PENDING, exécution, annulation, rejet) : une ligne de sortie.
+// Le nom de l'instrument et les textes bruts ne sont résolus qu'à l'écriture (voir SymbolTable).
+struct ExecutionReport {
+    uint64_t timestamp;             // Horodatage de l'événement
+    uint64_t order_id;              // Ordre concerné
+    union {
+        uint64_t counterparty_id;   // ID de l'ordre contrepartie (exécutions)
+        uint64_t raw_text;          // Rejet : textes bruts de l'ordre d'entrée (0 = aucun)
+    };
+    uint64_t quantity;              // Quantité restante de l'ordre
+    uint64_t executed_quantity;     // Quantité exécutée par l'événement
+    Price price;                    // Prix de l'ordre (en ticks)
+    Price execution_price;          // Prix d'exécution (en ticks)
+    SymbolId instrument;
+    Side side;
+    OrderType type;
+    Action action;
+    Status status;
+
+    ExecutionReport() : timestamp(0), order_id(0), counterparty_id(0), quantity(0),
+                        executed_quantity(0), price(0), execution_price(0), instrument(0),
+                        side(Side::NONE), type(OrderType::NONE), action(Action::NONE), status(Status::NONE) {}
+
+    // Rapport reprenant les attributs de l'ordre (statut et exécution à renseigner)
+    static ExecutionReport from_order(const Order& order);
+};
+
+static_assert(sizeof(ExecutionReport) <= 64, "ExecutionReport must fit in one cache line");
+
+// Implémentation
+
+ExecutionReport ExecutionReport::from_order(const Order& order) {
+    ExecutionReport report;
+    report.timestamp = order.timestamp;
+    report.order_id = order.order_id;
+    report.quantity = order.quantity;
+    report.price = order.price;
+    report.instrument = order.instrument;
+    report.side = order.side;
+    report.type = order.type;
+    report.action = order.action;
+    return report;
+}
+
+#endif // EXECUTION_REPORT_H
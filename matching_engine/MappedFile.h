@@ -0,0 +1,141 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Fichier d'entrée projeté en mémoire (lecture seule) : le parseur lit les lignes sur place.
+// Une source qui ne se projette pas (tube, FIFO, entrée standard) reste ouverte en flux : elle se lit
+// par blocs avec read(), ou entièrement avec load().
+class MappedFile {
+private:
+    const char* mapped;
+    size_t mapped_size;
+    std::string buffer;     // Contenu lu d'une source non projetable (début lu par peek(), ou tout après load())
+    int stream_fd;          // Source en flux encore ouverte (-1 sinon)
+    bool owns_fd;           // false pour l'entrée standard
+
+    void unmap();
+    void close_stream();
+
+public:
+    MappedFile() : mapped(nullptr), mapped_size(0), stream_fd(-1), owns_fd(false) {}
+    ~MappedFile() { unmap(); close_stream(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Retourne false si le fichier ne peut pas être ouvert ; "-" désigne l'entrée standard
+    bool open(const std::string& filename);
+
+    // Source en flux : contents() ne donne que ce qui a été chargé par load()
+    bool is_stream() const { return stream_fd >= 0; }
+    // Au plus `size` premiers octets d'une source en flux, sans les consommer
+    std::string_view peek(size_t size);
+    // Lit au plus `size` octets de la source en flux (ce qui est disponible) ; 0 à la fin.
+    // std::runtime_error en cas d'erreur de lecture.
+    size_t read(char* out, size_t size);
+    // Lit tout le reste de la source en flux, accessible ensuite par contents()
+    void load();
+
+    std::string_view contents() const {
+        return mapped ? std::string_view(mapped, mapped_size) : std::string_view(buffer);
+    }
+};
+
+// Implémentation
+
+bool MappedFile::open(const std::string& filename) {
+    unmap();
+    close_stream();
+    buffer.clear();
+
+    bool standard_input = filename == "-";
+    int fd = standard_input ? STDIN_FILENO : ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        if (info.st_size == 0) {
+            if (!standard_input) ::close(fd);
+            return true;
+        }
+        void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            // Lecture séquentielle : lecture anticipée agressive par le noyau
+            madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapped = static_cast<const char*>(address);
+            mapped_size = static_cast<size_t>(info.st_size);
+            if (!standard_input) ::close(fd);
+            return true;
+        }
+    }
+
+    // Repli : lecture en flux
+    stream_fd = fd;
+    owns_fd = !standard_input;
+    return true;
+}
+
+std::string_view MappedFile::peek(size_t size) {
+    char block[4096];
+    while (is_stream() && buffer.size() < size) {
+        ssize_t count = ::read(stream_fd, block, std::min(sizeof(block), size - buffer.size()));
+        if (count < 0 && errno == EINTR) continue;
+        if (count < 0) throw std::runtime_error(std::string("Read error: ") + std::strerror(errno));
+        if (count == 0) break;
+        buffer.append(block, static_cast<size_t>(count));
+    }
+    return std::string_view(buffer).substr(0, size);
+}
+
+size_t MappedFile::read(char* out, size_t size) {
+    if (!buffer.empty()) {
+        // D'abord les octets lus par peek()
+        size_t count = std::min(size, buffer.size());
+        std::memcpy(out, buffer.data(), count);
+        buffer.erase(0, count);
+        return count;
+    }
+    while (is_stream()) {
+        ssize_t count = ::read(stream_fd, out, size);
+        if (count >= 0) return static_cast<size_t>(count);
+        if (errno != EINTR) throw std::runtime_error(std::string("Read error: ") + std::strerror(errno));
+    }
+    return 0;
+}
+
+void MappedFile::load() {
+    char block[1 << 16];
+    while (is_stream()) {
+        ssize_t count = ::read(stream_fd, block, sizeof(block));
+        if (count < 0 && errno == EINTR) continue;
+        if (count < 0) throw std::runtime_error(std::string("Read error: ") + std::strerror(errno));
+        if (count == 0) break;
+        buffer.append(block, static_cast<size_t>(count));
+    }
+    close_stream();
+}
+
+void MappedFile::unmap() {
+    if (mapped) {
+        munmap(const_cast<char*>(mapped), mapped_size);
+        mapped = nullptr;
+        mapped_size = 0;
+    }
+}
+
+void MappedFile::close_stream() {
+    if (stream_fd >= 0 && owns_fd) ::close(stream_fd);
+    stream_fd = -1;
+}
+
+#endif // MAPPED_FILE_H
@@ -2,29 +2,82 @@
 #define MATCHING_ENGINE_H
 
 #include "Order.h"
+#include "ExecutionReport.h"
 #include "OrderBook.h"
-#include <unordered_map>
+#include "ResultSink.h"
+#include "Sequencer.h"
 #include <vector>
+#include <memory>
 #include <algorithm>
 
 // Moteur de matching des ordres
 class MatchingEngine {
 private:
-    // Carnets d'ordres par instrument (ex : AAPL, EURUSD, etc.)
-    std::unordered_map<std::string, OrderBook> order_books;
+    // Index des ordres par ID de tous les carnets (doublons d'ID et carnet de chaque ordre), dans sa propre
+    // arène ; déclaré avant les carnets qui le référencent
+    BookArena index_arena;
+    OrderIndex order_index;
+    // Nombre d'ordres déjà réservés dans l'index (voir reserve_book)
+    size_t reserved_orders;
+    // Carnets d'ordres indexés par identifiant d'instrument (voir SymbolTable)
+    std::vector<std::unique_ptr<OrderBook>> order_books;
+    // Taille de l'échelle de prix dense par instrument (0 = arbre uniquement, SIZE_MAX = défaut)
+    std::vector<size_t> ladder_ticks;
+    size_t default_ladder_ticks;
+    // Destination des événements de tous les carnets (nullptr = accumulation)
+    ResultSink* sink;
+    // Horloge des exécutions et séquence d'émission, propres au moteur et partagées par ses carnets
+    Sequencer sequencer;
+    // Horodatage différé des exécutions (moteur d'un shard, voir ShardedMatchingEngine)
+    bool deferred_timestamps;
+
+    // Récupère (ou crée) le carnet d'un instrument
+    OrderBook& get_book(SymbolId instrument);
+    // Traite un ordre dans son carnet, déjà résolu
+    void process_in_book(OrderBook& book, const Order& order);
     
 public:
     // Constructeur
-    MatchingEngine() {
-        // Réinitialise le compteur global de timestamps
-        OrderBook::reset_global_counter();
+    MatchingEngine()
+        : order_index(index_arena), reserved_orders(0), default_ladder_ticks(0), sink(nullptr),
+          deferred_timestamps(false) {
+        order_index.set_retention(true);
     }
+
+    // Les carnets référencent l'index et le séquenceur du moteur : ni copie ni déplacement
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
     
+    // Choix du stockage des limites, à configurer avant le premier ordre de l'instrument
+    void set_price_ladder(SymbolId instrument, size_t ticks);
+    void set_default_price_ladder(size_t ticks);
+
+    // Préalloue la mémoire du carnet d'un instrument (voir OrderBook::reserve)
+    void reserve_book(SymbolId instrument, size_t orders, size_t levels);
+
+    // Nombre d'allocations sur le tas effectuées par les structures des carnets
+    uint64_t book_allocation_count() const;
+
+    // Index des ordres (taille de la table, IDs retirés, mémoire occupée)
+    const OrderIndex& get_order_index() const { return order_index; }
+
+    // Transmet les événements au fil de l'eau à `result_sink` (nullptr : retour à l'accumulation).
+    // Avec un sink, get_all_results ne retourne que ce qui a été accumulé auparavant.
+    void set_sink(ResultSink* result_sink);
+
+    // Voir OrderBook::set_deferred_timestamps (à configurer avant le premier ordre)
+    void set_deferred_timestamps(bool deferred) { deferred_timestamps = deferred; }
+
     // Traite un ordre (NEW, MODIFY, CANCEL)
     void process_order(const Order& order);
+
+    // Traite `count` ordres dans l'ordre, avec le même résultat que process_order sur chacun. Les carnets
+    // du lot sont résolus d'avance et les entrées d'index et limites des ordres suivants préchargées.
+    void process_batch(const Order* orders, size_t count);
+    void process_batch(const std::vector<Order>& orders) { process_batch(orders.data(), orders.size()); }
     
-    // Récupère tous les résultats
-    std::vector<Order> get_all_results();
+    // Récupère tous les résultats, triés par timestamp puis par ordre d'émission
+    std::vector<ExecutionReport> get_all_results();
     
     // Efface les résultats
     void clear_results();
@@ -32,53 +85,158 @@ public:
 
 // Implémentation
 
+OrderBook& MatchingEngine::get_book(SymbolId instrument) {
+    if (instrument >= order_books.size()) {
+        order_books.resize(instrument + 1);
+    }
+    std::unique_ptr<OrderBook>& book = order_books[instrument];
+    if (!book) {
+        size_t ticks = default_ladder_ticks;
+        if (instrument < ladder_ticks.size() && ladder_ticks[instrument] != SIZE_MAX) {
+            ticks = ladder_ticks[instrument];
+        }
+        book.reset(new OrderBook(ticks));
+        book->set_sink(sink);
+        book->set_sequencer(&sequencer);
+        book->set_order_index(&order_index);
+        book->set_deferred_timestamps(deferred_timestamps);
+    }
+    return *book;
+}
+
+void MatchingEngine::set_price_ladder(SymbolId instrument, size_t ticks) {
+    if (instrument >= ladder_ticks.size()) {
+        ladder_ticks.resize(instrument + 1, SIZE_MAX);
+    }
+    ladder_ticks[instrument] = ticks;
+}
+
+void MatchingEngine::set_default_price_ladder(size_t ticks) {
+    default_ladder_ticks = ticks;
+}
+
+void MatchingEngine::set_sink(ResultSink* result_sink) {
+    sink = result_sink;
+    for (auto& book : order_books) {
+        if (book) book->set_sink(sink);
+    }
+}
+
+void MatchingEngine::reserve_book(SymbolId instrument, size_t orders, size_t levels) {
+    // L'index est commun : il est dimensionné pour le total des réservations
+    reserved_orders += orders;
+    order_index.reserve(reserved_orders);
+    get_book(instrument).reserve(orders, levels);
+}
+
+uint64_t MatchingEngine::book_allocation_count() const {
+    uint64_t total = index_arena.heap_allocation_count();
+    for (const auto& book : order_books) {
+        if (book) total += book->allocation_count();
+    }
+    return total;
+}
+
 void MatchingEngine::process_order(const Order& order) {
+    // Récupère le carnet d'ordres de l'instrument
+    process_in_book(get_book(order.instrument), order);
+}
+
+void MatchingEngine::process_batch(const Order* orders, size_t count) {
+    // Distance de préchargement : quelques ordres d'avance couvrent la latence mémoire
+    constexpr size_t prefetch_distance = 8;
+    constexpr size_t block = 256;
+    OrderBook* books[block];
+
+    for (size_t start = 0; start < count; start += block) {
+        size_t size = std::min(block, count - start);
+        const Order* batch = orders + start;
+        for (size_t i = 0; i < size; ++i) {
+            books[i] = &get_book(batch[i].instrument);
+        }
+        for (size_t i = 0; i < std::min(prefetch_distance, size); ++i) {
+            books[i]->prefetch(batch[i]);
+        }
+        for (size_t i = 0; i < size; ++i) {
+            if (i + prefetch_distance < size) {
+                books[i + prefetch_distance]->prefetch(batch[i + prefetch_distance]);
+            }
+            process_in_book(*books[i], batch[i]);
+        }
+    }
+}
+
+void MatchingEngine::process_in_book(OrderBook& book, const Order& order) {
     // Ignore les ordres rejetés
-    if (order.status == "REJECTED") {
-        order_books[order.instrument].results.push_back(order);
+    if (order.status == Status::REJECTED) {
+        book.reject_order(order);
         return;
     }
-    
-    // Récupère le carnet d'ordres de l'instrument
-    OrderBook& book = order_books[order.instrument];
-    
+
     // Traite l'action de l'ordre
-    if (order.action == "NEW") {
+    if (order.action == Action::NEW) {
         book.add_order(order);
-    } else if (order.action == "MODIFY") {
+    } else if (order.action == Action::MODIFY) {
         book.modify_order(order);
-    } else if (order.action == "CANCEL") {
+    } else if (order.action == Action::CANCEL) {
         book.cancel_order(order);
     }
 }
 
-std::vector<Order> MatchingEngine::get_all_results() {
-    std::vector<Order> all_results;
-    
-    // Rassemble les résultats de tous les carnets
-    for (auto& [instrument, book] : order_books) {
-        for (const auto& result : book.results) {
-            all_results.push_back(result);
+std::vector<ExecutionReport> MatchingEngine::get_all_results() {
+    // Chaque carnet émet par timestamp croissant, sauf les rejets qui gardent celui de l'entrée :
+    // on découpe ses résultats en séquences croissantes, puis fusion k-voies par (timestamp, séquence)
+    struct Run {
+        const ExecutionReport* reports;
+        const uint64_t* sequences;
+        size_t position;
+        size_t end;
+    };
+    std::vector<Run> runs;
+    size_t total = 0;
+    for (const auto& book : order_books) {
+        if (!book || book->results.empty()) continue;
+        const std::vector<ExecutionReport>& results = book->results;
+        size_t start = 0;
+        for (size_t i = 1; i < results.size(); ++i) {
+            if (results[i].timestamp < results[i - 1].timestamp) {
+                runs.push_back(Run{results.data(), book->result_sequences.data(), start, i});
+                start = i;
+            }
         }
+        runs.push_back(Run{results.data(), book->result_sequences.data(), start, results.size()});
+        total += results.size();
     }
-    
-    // Trie les résultats par timestamp
-    std::stable_sort(all_results.begin(), all_results.end(),
-              [](const Order& a, const Order& b) {
-                  if (a.timestamp == b.timestamp) {
-                      // Si timestamps identiques, conserve l'ordre d'apparition
-                      return false;
-                  }
-                  return a.timestamp < b.timestamp;
-              });
-    
+
+    // Tas minimum sur la tête de chaque séquence
+    auto comes_after = [](const Run& a, const Run& b) {
+        uint64_t ts_a = a.reports[a.position].timestamp;
+        uint64_t ts_b = b.reports[b.position].timestamp;
+        if (ts_a != ts_b) return ts_a > ts_b;
+        return a.sequences[a.position] > b.sequences[b.position];
+    };
+    std::make_heap(runs.begin(), runs.end(), comes_after);
+
+    std::vector<ExecutionReport> all_results;
+    all_results.reserve(total);
+    while (!runs.empty()) {
+        std::pop_heap(runs.begin(), runs.end(), comes_after);
+        Run& run = runs.back();
+        all_results.push_back(run.reports[run.position++]);
+        if (run.position == run.end) {
+            runs.pop_back();
+        } else {
+            std::push_heap(runs.begin(), runs.end(), comes_after);
+        }
+    }
+
     return all_results;
 }
 
 void MatchingEngine::clear_results() {
     // Efface les résultats dans chaque carnet
-    for (auto& [instrument, book] : order_books) {
-        book.results.clear();
+    for (auto& book : order_books) {
+        if (book) book->clear_results();
     }
 }
 
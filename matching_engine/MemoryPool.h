@@ -0,0 +1,145 @@
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Pool de blocs de taille fixe : tranches (slabs) allouées sur le tas, réutilisation par liste libre
+class MemoryPool {
+private:
+    struct FreeBlock { FreeBlock* next; };
+    struct Slab { Slab* next; };
+
+    // En-tête de tranche arrondi pour conserver l'alignement des blocs
+    static constexpr size_t slab_header = 16;
+
+    size_t block_size;
+    size_t blocks_per_slab;
+    FreeBlock* free_list;
+    Slab* slabs;
+    uint64_t* heap_allocations;     // Compteur partagé de l'arène
+
+public:
+    MemoryPool() : block_size(0), blocks_per_slab(0), free_list(nullptr), slabs(nullptr), heap_allocations(nullptr) {}
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    ~MemoryPool() {
+        while (slabs) {
+            Slab* next = slabs->next;
+            ::operator delete(slabs);
+            slabs = next;
+        }
+    }
+
+    void init(size_t size, uint64_t* counter) {
+        block_size = size;
+        blocks_per_slab = (16384 / size > 64) ? 16384 / size : 64;
+        heap_allocations = counter;
+    }
+
+    bool initialized() const { return block_size != 0; }
+
+    void* allocate() {
+        if (free_list == nullptr) grow();
+        FreeBlock* block = free_list;
+        free_list = block->next;
+        return block;
+    }
+
+    void deallocate(void* p) {
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = free_list;
+        free_list = block;
+    }
+
+private:
+    // Alloue une nouvelle tranche et chaîne ses blocs dans la liste libre
+    void grow() {
+        char* memory = static_cast<char*>(::operator new(slab_header + block_size * blocks_per_slab));
+        (*heap_allocations)++;
+        Slab* slab = reinterpret_cast<Slab*>(memory);
+        slab->next = slabs;
+        slabs = slab;
+
+        char* first = memory + slab_header;
+        for (size_t i = blocks_per_slab; i-- > 0;) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(first + i * block_size);
+            block->next = free_list;
+            free_list = block;
+        }
+    }
+};
+
+// Arène d'un carnet : un pool par classe de taille (multiples de 16 octets).
+// Les demandes plus grandes (tableaux de buckets) vont directement sur le tas.
+class BookArena {
+private:
+    static constexpr size_t size_step = 16;
+    static constexpr size_t size_classes = 32;
+
+    MemoryPool pools[size_classes];
+    uint64_t heap_allocations;
+
+    static size_t class_of(size_t size) { return (size == 0) ? 0 : (size + size_step - 1) / size_step - 1; }
+
+public:
+    BookArena() : heap_allocations(0) {}
+
+    BookArena(const BookArena&) = delete;
+    BookArena& operator=(const BookArena&) = delete;
+
+    void* allocate(size_t size) {
+        size_t index = class_of(size);
+        if (index >= size_classes) {
+            heap_allocations++;
+            return ::operator new(size);
+        }
+        if (!pools[index].initialized()) {
+            pools[index].init((index + 1) * size_step, &heap_allocations);
+        }
+        return pools[index].allocate();
+    }
+
+    void deallocate(void* p, size_t size) {
+        size_t index = class_of(size);
+        if (index >= size_classes) {
+            ::operator delete(p);
+            return;
+        }
+        pools[index].deallocate(p);
+    }
+
+    // Nombre total d'allocations effectuées sur le tas par l'arène
+    uint64_t heap_allocation_count() const { return heap_allocations; }
+};
+
+// Allocateur compatible STL qui puise dans l'arène du carnet
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    BookArena* arena;
+
+    explicit PoolAllocator(BookArena* a) : arena(a) {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        arena->deallocate(p, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) { return a.arena == b.arena; }
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) { return a.arena != b.arena; }
+
+#endif // MEMORY_POOL_H
@@ -2,41 +2,115 @@
 #define ORDER_H
 
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include "Price.h"
 
-// Structure représentant un ordre (BUY ou SELL)
+// Identifiant interne d'un instrument (voir SymbolTable)
+using SymbolId = uint32_t;
+
+// Côté de l'ordre
+enum class Side : uint8_t { NONE, BUY, SELL };
+// Type d'ordre
+enum class OrderType : uint8_t { NONE, LIMIT, MARKET };
+// Action demandée
+enum class Action : uint8_t { NONE, NEW, MODIFY, CANCEL };
+// Statut de l'ordre en sortie
+enum class Status : uint8_t { NONE, PENDING, EXECUTED, PARTIALLY_EXECUTED, CANCELED, REJECTED };
+
+// Structure représentant un ordre (BUY ou SELL) : enregistrement compact sans chaîne.
+// Les résultats du matching sont des ExecutionReport.
 struct Order {
     uint64_t timestamp;         // Horodatage de l'ordre
     uint64_t order_id;          // Identifiant unique
-    std::string instrument;     // Instrument financier (ex: AAPL)
-    std::string side;           // Côté (BUY ou SELL)
-    std::string type;           // Type d'ordre (LIMIT, MARKET, etc.)
     uint64_t quantity;          // Quantité
-    double price;               // Prix
-    std::string action;         // Action (NEW, MODIFY, CANCEL)
-    
-    // Champs supplémentaires pour la sortie
-    std::string status;         // Statut de l'ordre (EXECUTED, REJECTED, etc.)
-    uint64_t executed_quantity; // Quantité exécutée
-    double execution_price;     // Prix d'exécution
-    uint64_t counterparty_id;   // ID de l'ordre contrepartie
-    
+    Price price;                // Prix (en ticks)
+    SymbolId instrument;        // Instrument financier (ex: AAPL), interné
+    Side side;                  // Côté (BUY ou SELL)
+    OrderType type;             // Type d'ordre (LIMIT, MARKET)
+    Action action;              // Action (NEW, MODIFY, CANCEL)
+    Status status;              // Statut de l'ordre en entrée (REJECTED si invalide)
+    uint32_t raw_text;          // Textes bruts d'un ordre rejeté (0 = aucun, voir SymbolTable)
+
     // Constructeur par défaut
-    Order() : timestamp(0), order_id(0), quantity(0), price(0.0), 
-              executed_quantity(0), execution_price(0.0), counterparty_id(0) {}
-              
-    // Constructeur de copie par défaut
-    Order(const Order& other) = default;
-    Order& operator=(const Order& other) = default;
+    Order() : timestamp(0), order_id(0), quantity(0), price(0),
+              instrument(0), side(Side::NONE), type(OrderType::NONE),
+              action(Action::NONE), status(Status::NONE), raw_text(0) {}
 };
 
-// Structure représentant une exécution (trade)
-struct Trade {
-    Order buy_order;    // Ordre acheteur
-    Order sell_order;   // Ordre vendeur
-    uint64_t quantity;  // Quantité échangée
-    double price;       // Prix d'exécution
-    uint64_t timestamp; // Horodatage de l'exécution
-};
+static_assert(sizeof(Order) <= 64, "Order must fit in one cache line");
+
+// Conversions texte <-> énumérations (valeurs canoniques en majuscules)
+const char* to_string(Side side);
+const char* to_string(OrderType type);
+const char* to_string(Action action);
+const char* to_string(Status status);
+bool parse_side(std::string_view str, Side& side);
+bool parse_order_type(std::string_view str, OrderType& type);
+bool parse_action(std::string_view str, Action& action);
+
+// Implémentation
+
+const char* to_string(Side side) {
+    switch (side) {
+        case Side::BUY: return "BUY";
+        case Side::SELL: return "SELL";
+        default: return "";
+    }
+}
+
+const char* to_string(OrderType type) {
+    switch (type) {
+        case OrderType::LIMIT: return "LIMIT";
+        case OrderType::MARKET: return "MARKET";
+        default: return "";
+    }
+}
+
+const char* to_string(Action action) {
+    switch (action) {
+        case Action::NEW: return "NEW";
+        case Action::MODIFY: return "MODIFY";
+        case Action::CANCEL: return "CANCEL";
+        default: return "";
+    }
+}
+
+const char* to_string(Status status) {
+    switch (status) {
+        case Status::PENDING: return "PENDING";
+        case Status::EXECUTED: return "EXECUTED";
+        case Status::PARTIALLY_EXECUTED: return "PARTIALLY_EXECUTED";
+        case Status::CANCELED: return "CANCELED";
+        case Status::REJECTED: return "REJECTED";
+        default: return "";
+    }
+}
+
+// Une chaîne vide correspond à NONE ; toute autre valeur non canonique est refusée
+bool parse_side(std::string_view str, Side& side) {
+    if (str.empty()) side = Side::NONE;
+    else if (str == "BUY") side = Side::BUY;
+    else if (str == "SELL") side = Side::SELL;
+    else return false;
+    return true;
+}
+
+bool parse_order_type(std::string_view str, OrderType& type) {
+    if (str.empty()) type = OrderType::NONE;
+    else if (str == "LIMIT") type = OrderType::LIMIT;
+    else if (str == "MARKET") type = OrderType::MARKET;
+    else return false;
+    return true;
+}
+
+bool parse_action(std::string_view str, Action& action) {
+    if (str.empty()) action = Action::NONE;
+    else if (str == "NEW") action = Action::NEW;
+    else if (str == "MODIFY") action = Action::MODIFY;
+    else if (str == "CANCEL") action = Action::CANCEL;
+    else return false;
+    return true;
+}
 
 #endif // ORDER_H
@@ -2,244 +2,359 @@
 #define ORDER_BOOK_H
 
 #include "Order.h"
-#include <map>
-#include <queue>
-#include <unordered_map>
+#include "ExecutionReport.h"
+#include "ResultSink.h"
+#include "PriceLevels.h"
+#include "OrderIndex.h"
+#include "Sequencer.h"
 #include <vector>
 #include <algorithm>
-
-// File d'attente d'ordres pour une même limite de prix
-struct OrderQueue {
-    std::queue<Order> orders;
-    uint64_t total_quantity;
-
-    OrderQueue() : total_quantity(0) {}
-
-    void add_order(const Order& order) {
-        orders.push(order);
-        total_quantity += order.quantity;
-    }
-
-    bool empty() const {
-        return orders.empty();
-    }
-
-    Order& front() {
-        return orders.front();
-    }
-
-    void pop() {
-        if (!orders.empty()) {
-            total_quantity -= orders.front().quantity;
-            orders.pop();
-        }
-    }
-
-    void update_quantity(uint64_t executed_qty) {
-        total_quantity -= executed_qty;
-    }
-};
+#include <new>
 
 // Carnet d'ordres pour un instrument donné
 class OrderBook {
 private:
+    // Arène des noeuds d'ordres et des limites (déclarée en premier : détruite en dernier)
+    BookArena arena;
     // Carnet d'ordres BUY : trié par prix décroissant
-    std::map<double, OrderQueue, std::greater<double>> buy_orders;
+    PriceLevels<std::greater<Price>> buy_orders;
     // Carnet d'ordres SELL : trié par prix croissant
-    std::map<double, OrderQueue> sell_orders;
-    // Accès rapide aux ordres par ID
-    std::unordered_map<uint64_t, Order> order_lookup;
-    // Suivi des IDs d'ordres existants
-    std::unordered_map<uint64_t, bool> existing_order_ids;
-    // Suivi des quantités exécutées par ordre (utile pour MODIFY)
-    std::unordered_map<uint64_t, uint64_t> order_total_executed;
-    // Horodatage global pour les exécutions
-    static uint64_t global_timestamp_counter;
+    PriceLevels<std::less<Price>> sell_orders;
+    // Index par ID (IDs déjà vus, quantités exécutées et noeuds des ordres) : index du moteur,
+    // partagé par ses carnets, ou index propre au carnet isolé
+    OrderIndex local_index;
+    OrderIndex* order_index;
+    // Destination des événements (nullptr = accumulation dans results)
+    ResultSink* sink;
+    // Horloge et séquence d'émission : séquenceur du moteur, ou séquenceur propre au carnet isolé
+    Sequencer local_sequencer;
+    Sequencer* sequencer;
+    // Horodatage différé (shards) : le carnet signale l'origine de l'horodatage de chaque événement
+    bool deferred_timestamps;
+    StampKind next_stamp;
 
 public:
-    std::vector<Order> results;
-    // Résultats des traitements d'ordres
-    OrderBook() {}
+    // Résultats des traitements d'ordres (quand aucun sink n'est branché)
+    std::vector<ExecutionReport> results;
+    // Numéro de séquence d'émission de chaque résultat (même indice que results)
+    std::vector<uint64_t> result_sequences;
+    // ladder_ticks : taille de l'échelle de prix dense par côté (0 = arbre uniquement)
+    explicit OrderBook(size_t ladder_ticks = 0)
+        : buy_orders(ladder_ticks, arena), sell_orders(ladder_ticks, arena),
+          local_index(arena), order_index(&local_index), sink(nullptr), sequencer(&local_sequencer),
+          deferred_timestamps(false), next_stamp(StampKind::LITERAL) {
+        local_index.set_retention(true);
+    }
 
-    static void reset_global_counter() { global_timestamp_counter = 0; }
+    // Les conteneurs référencent l'arène : le carnet ne doit pas être copié ni déplacé
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
+    // Préalloue la mémoire pour `orders` ordres et `levels` limites de prix
+    // (à appeler avant le premier ordre : aucune allocation ensuite tant que ces volumes ne sont pas dépassés)
+    void reserve(size_t orders, size_t levels);
+    // Nombre d'allocations sur le tas effectuées par les structures du carnet
+    uint64_t allocation_count() const { return arena.heap_allocation_count(); }
+
+    // Mode différé : les exécutions gardent le timestamp de la requête et le sink reçoit
+    // l'origine de chaque horodatage (on_deferred_report) pour l'appliquer plus tard dans l'ordre global
+    void set_deferred_timestamps(bool deferred) { deferred_timestamps = deferred; }
+
+    // Branche un sink : les événements lui sont transmis au lieu d'être accumulés
+    void set_sink(ResultSink* result_sink) { sink = result_sink; }
+
+    // Partage le séquenceur entre les carnets d'un même moteur
+    void set_sequencer(Sequencer* engine_sequencer) { sequencer = engine_sequencer; }
+
+    // Partage l'index des ordres entre les carnets d'un même moteur (avant le premier ordre) :
+    // un ID ne peut alors être utilisé que par un seul carnet
+    void set_order_index(OrderIndex* engine_index) { order_index = engine_index; }
+
+    // Publie un événement vers le sink ou dans results (avec son numéro de séquence)
+    void emit(const ExecutionReport& report) {
+        if (sink && deferred_timestamps) {
+            sink->on_deferred_report(report, next_stamp);
+            // Le second événement d'une exécution partage l'horodatage du premier
+            if (next_stamp == StampKind::NEW) next_stamp = StampKind::SAME;
+        } else if (sink) {
+            sink->on_report(report);
+        } else {
+            results.push_back(report);
+            result_sequences.push_back(sequencer->next_emission());
+        }
+    }
+
+    void clear_results() {
+        results.clear();
+        result_sequences.clear();
+    }
 
     void add_order(Order order);
     void modify_order(const Order& modify_request);
     void cancel_order(const Order& cancel_request);
+    // Publie le rejet d'un ordre invalide en entrée (textes bruts conservés)
+    void reject_order(const Order& order);
+
+    // Quantité restante au repos sur une limite de prix (0 si la limite n'existe pas)
+    uint64_t resting_quantity(Side side, Price price) {
+        OrderQueue* level = (side == Side::BUY) ? buy_orders.find(price) : sell_orders.find(price);
+        return level ? level->total_quantity : 0;
+    }
+
+    // Précharge ce que le traitement de l'ordre va lire : son entrée d'index et sa limite de prix
+    void prefetch(const Order& order) const {
+        order_index->prefetch(order.order_id);
+        if (order.side == Side::BUY) buy_orders.prefetch(order.price);
+        else sell_orders.prefetch(order.price);
+    }
 
 private:
-    void execute_market_order(Order order);
-    void execute_buy_market_order(Order order);
-    void execute_sell_market_order(Order order);
-    void execute_limit_order(Order order);
-    void execute_buy_limit_order(Order order);
-    void execute_sell_limit_order(Order order);
-    void cancel_order_from_book(const Order& order);
-    void record_execution(const Order& order, uint64_t executed_qty);
+    // `slot` est l'entrée de l'ordre agresseur (aucune insertion dans l'index pendant le matching)
+    void execute_market_order(Order order, OrderSlot& slot);
+    void execute_buy_market_order(Order order, OrderSlot& slot);
+    void execute_sell_market_order(Order order, OrderSlot& slot);
+    void execute_limit_order(Order order, OrderSlot& slot);
+    void execute_buy_limit_order(Order order, OrderSlot& slot);
+    void execute_sell_limit_order(Order order, OrderSlot& slot);
+    void cancel_order_from_book(OrderNode& node);
+    void record_execution(OrderSlot& slot, uint64_t executed_qty, uint64_t remaining_qty);
+    void fill_resting_order(OrderQueue& order_queue, uint64_t executed_qty);
+    OrderNode* allocate_node();
+    void release_node(OrderSlot& slot);
     uint64_t get_next_execution_timestamp(uint64_t base_timestamp);
 };
 
-// Implémentation du compteur global
-uint64_t OrderBook::global_timestamp_counter = 0;
-// Calcule le prochain timestamp pour une exécution
+// Implémentation
+
+// Calcule le prochain timestamp pour une exécution (différé : timestamp de la requête)
 uint64_t OrderBook::get_next_execution_timestamp(uint64_t base_timestamp) {
-    static uint64_t last_execution_timestamp = 0;
-    uint64_t next_timestamp = std::max(base_timestamp, last_execution_timestamp + 100);
-    last_execution_timestamp = next_timestamp;
-    return next_timestamp;
+    if (deferred_timestamps) {
+        next_stamp = StampKind::NEW;
+        return base_timestamp;
+    }
+    return sequencer->next_execution_timestamp(base_timestamp);
 }
 
-// Ajoute un ordre dans le carnet
-void OrderBook::add_order(Order order) {
-    // Vérifie si l'ID existe déjà
-    if (order.action == "NEW" && existing_order_ids.find(order.order_id) != existing_order_ids.end()) {
-        order.status = "REJECTED";
-        order.executed_quantity = 0;
-        order.execution_price = 0.0;
-        order.counterparty_id = 0;
-        results.push_back(order);
+// Préchauffe les pools : insère puis libère des noeuds factices pour remplir les listes libres
+void OrderBook::reserve(size_t orders, size_t levels) {
+    if (!buy_orders.empty() || !sell_orders.empty()) {
         return;
     }
 
-    // Marque l'ID comme existant pour les NEW
-    if (order.action == "NEW") {
-        existing_order_ids[order.order_id] = true;
-        order_total_executed[order.order_id] = 0;
+    order_index->reserve(orders);
+    std::vector<void*> nodes(orders);
+    for (size_t i = 0; i < orders; ++i) {
+        nodes[i] = arena.allocate(sizeof(OrderNode));
+    }
+    for (void* node : nodes) {
+        arena.deallocate(node, sizeof(OrderNode));
+    }
+
+    buy_orders.reserve(levels);
+    sell_orders.reserve(levels);
+}
+
+// Noeud d'ordre pris dans le pool de l'arène
+OrderNode* OrderBook::allocate_node() {
+    return new (arena.allocate(sizeof(OrderNode))) OrderNode();
+}
+
+// Rend le noeud d'un ordre terminé (sorti du carnet ou jamais placé) ; l'entrée d'index est conservée
+void OrderBook::release_node(OrderSlot& slot) {
+    slot.node->~OrderNode();
+    arena.deallocate(slot.node, sizeof(OrderNode));
+    slot.node = nullptr;
+}
+
+// Ajoute un ordre dans le carnet
+void OrderBook::add_order(Order order) {
+    next_stamp = StampKind::LITERAL;
+    // Vérifie si l'ID existe déjà, et l'enregistre sinon (quantité exécutée nulle)
+    bool inserted;
+    OrderSlot* slot = order_index->find_or_insert(order.order_id, inserted);
+    // ID retiré (ordre terminé) : il ne peut être ni réutilisé ni repris
+    if (slot == nullptr || (order.action == Action::NEW && !inserted)) {
+        ExecutionReport rejected = ExecutionReport::from_order(order);
+        rejected.status = Status::REJECTED;
+        emit(rejected);
+        return;
     }
+    slot->instrument = order.instrument;
 
     // Initialise l'état de l'ordre
-    order.status = "PENDING";
-    order.executed_quantity = 0;
-    order.execution_price = 0.0;
-    order.counterparty_id = 0;
+    order.status = Status::PENDING;
 
     // Sauvegarde de l'ordre
-    order_lookup[order.order_id] = order;
+    if (slot->node == nullptr) {
+        slot->node = allocate_node();
+    }
+    slot->node->order = order;
 
     // Exécute selon le type d'ordre
-    if (order.type == "MARKET") {
-        execute_market_order(order);
+    if (order.type == OrderType::MARKET) {
+        execute_market_order(order, *slot);
     }
-    else if (order.type == "LIMIT") {
-        execute_limit_order(order);
+    else if (order.type == OrderType::LIMIT) {
+        execute_limit_order(order, *slot);
     }
 }
 
 // Modifie un ordre existant
 void OrderBook::modify_order(const Order& modify_request) {
-    auto it = order_lookup.find(modify_request.order_id);
-    // Si l'ordre n'existe pas, rejeté
-    if (it == order_lookup.end()) {
-        Order rejected = modify_request;
-        rejected.status = "REJECTED";
-        results.push_back(rejected);
+    next_stamp = StampKind::LITERAL;
+    OrderSlot* slot = order_index->find(modify_request.order_id);
+    // Si l'ordre n'existe pas (ou pas dans ce carnet), rejeté
+    if (slot == nullptr || slot->node == nullptr || slot->instrument != modify_request.instrument) {
+        ExecutionReport rejected = ExecutionReport::from_order(modify_request);
+        rejected.status = Status::REJECTED;
+        emit(rejected);
         return;
     }
 
-    // Retire l'ancien ordre du carnet
-    cancel_order_from_book(it->second);
+    OrderNode& node = *slot->node;
 
     // Récupère le total exécuté jusque-là
-    uint64_t total_executed = order_total_executed[modify_request.order_id];
+    uint64_t total_executed = slot->total_executed;
 
     // Quantité restante après modification
     uint64_t new_total_quantity = modify_request.quantity;
     uint64_t remaining_quantity = (new_total_quantity > total_executed) ?
         (new_total_quantity - total_executed) : 0;
 
+    // Baisse de quantité au même prix d'un ordre au repos : ajustée sur place, l'ordre garde sa priorité
+    // (le carnet n'étant pas croisé, le matching ne trouverait rien)
+    if (node.level != nullptr && remaining_quantity > 0 && remaining_quantity < node.order.quantity &&
+        modify_request.price == node.order.price) {
+        uint64_t old_leaves = node.order.quantity;
+        node.order.quantity = new_total_quantity;
+        ExecutionReport pending_order = ExecutionReport::from_order(node.order);
+        pending_order.timestamp = get_next_execution_timestamp(modify_request.timestamp);
+        pending_order.action = Action::MODIFY;
+        pending_order.status = Status::PENDING;
+        emit(pending_order);
+
+        node.level->update_quantity(old_leaves - remaining_quantity);
+        node.order.quantity = remaining_quantity;
+        return;
+    }
+
+    // Retire l'ancien ordre du carnet
+    cancel_order_from_book(node);
+
     // Prépare un ordre temporaire pour traitement
-    Order processing_order = it->second;
+    Order processing_order = node.order;
     processing_order.quantity = remaining_quantity;
     processing_order.price = modify_request.price;
     processing_order.timestamp = modify_request.timestamp;
-    processing_order.action = "MODIFY";
+    processing_order.action = Action::MODIFY;
 
     // Met à jour l'ordre d'origine
-    it->second.quantity = modify_request.quantity;
-    it->second.price = modify_request.price;
-    order_lookup[modify_request.order_id] = it->second;
+    node.order.quantity = modify_request.quantity;
+    node.order.price = modify_request.price;
 
     // Si il reste des quantités : on le traite
     if (remaining_quantity > 0) {
-        if (processing_order.type == "MARKET") {
-            execute_market_order(processing_order);
+        if (processing_order.type == OrderType::MARKET) {
+            execute_market_order(processing_order, *slot);
         }
-        else if (processing_order.type == "LIMIT") {
-            execute_limit_order(processing_order);
+        else if (processing_order.type == OrderType::LIMIT) {
+            execute_limit_order(processing_order, *slot);
         }
     }
     else {
         // Sinon on le marque comme EXECUTED
-        Order result_order = order_lookup[modify_request.order_id];
+        slot->status = Status::EXECUTED;
+        ExecutionReport result_order = ExecutionReport::from_order(node.order);
         result_order.timestamp = get_next_execution_timestamp(modify_request.timestamp);
-        result_order.action = "MODIFY";
-        result_order.status = "EXECUTED";
-        result_order.executed_quantity = 0;
-        result_order.execution_price = 0.0;
-        result_order.counterparty_id = 0;
-        results.push_back(result_order);
+        result_order.action = Action::MODIFY;
+        result_order.status = Status::EXECUTED;
+        emit(result_order);
+        release_node(*slot);
     }
 }
 
 // Annule un ordre existant
 void OrderBook::cancel_order(const Order& cancel_request) {
-    auto it = order_lookup.find(cancel_request.order_id);
-    // Si l'ordre n'existe pas : rejeté
-    if (it == order_lookup.end()) {
-        Order rejected = cancel_request;
-        rejected.status = "REJECTED";
-        results.push_back(rejected);
+    next_stamp = StampKind::LITERAL;
+    OrderSlot* slot = order_index->find(cancel_request.order_id);
+    // Si l'ordre n'existe pas (ou pas dans ce carnet) : rejeté
+    if (slot == nullptr || slot->node == nullptr || slot->instrument != cancel_request.instrument) {
+        ExecutionReport rejected = ExecutionReport::from_order(cancel_request);
+        rejected.status = Status::REJECTED;
+        emit(rejected);
         return;
     }
 
     // Retire l'ordre du carnet
-    cancel_order_from_book(it->second);
+    cancel_order_from_book(*slot->node);
 
     // Prépare l'ordre CANCEL pour la sortie
-    Order cancelled = it->second;
+    ExecutionReport cancelled = ExecutionReport::from_order(slot->node->order);
     cancelled.timestamp = get_next_execution_timestamp(cancel_request.timestamp);
-    cancelled.action = "CANCEL";
-    cancelled.status = "CANCELED";
+    cancelled.action = Action::CANCEL;
+    cancelled.status = Status::CANCELED;
     cancelled.quantity = 0;
     cancelled.price = cancel_request.price; // Use price from cancel request
-    cancelled.executed_quantity = 0;
-    cancelled.execution_price = 0.0;
-    cancelled.counterparty_id = 0;
-    results.push_back(cancelled);
+    emit(cancelled);
 
-    // Retire l'ordre du lookup
-    order_lookup.erase(it);
+    // Libère le noeud de l'ordre
+    slot->status = Status::CANCELED;
+    release_node(*slot);
 }
 
-// Met à jour la quantité exécutée pour un ordre
-void OrderBook::record_execution(const Order& order, uint64_t executed_qty) {
-    order_total_executed[order.order_id] += executed_qty;
+// Rejet d'entrée : garde le timestamp de l'ordre
+void OrderBook::reject_order(const Order& order) {
+    next_stamp = StampKind::LITERAL;
+    ExecutionReport rejected = ExecutionReport::from_order(order);
+    rejected.status = Status::REJECTED;
+    rejected.raw_text = order.raw_text;
+    emit(rejected);
+}
+
+// Met à jour la quantité exécutée et le statut d'un ordre
+void OrderBook::record_execution(OrderSlot& slot, uint64_t executed_qty, uint64_t remaining_qty) {
+    slot.total_executed += executed_qty;
+    slot.status = (remaining_qty == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
+}
+
+// Exécution de l'ordre en tête de file ; un ordre entièrement exécuté sort du carnet
+void OrderBook::fill_resting_order(OrderQueue& order_queue, uint64_t executed_qty) {
+    OrderNode* node = order_queue.head;
+    OrderSlot& slot = *order_index->find(node->order.order_id);
+    record_execution(slot, executed_qty, node->order.quantity);
+    if (node->order.quantity == 0) {
+        order_queue.pop();
+        release_node(slot);
+    }
 }
 
 // Exécute un ordre MARKET (BUY ou SELL)
-void OrderBook::execute_market_order(Order order) {
-    if (order.side == "BUY") {
-        execute_buy_market_order(order);
+void OrderBook::execute_market_order(Order order, OrderSlot& slot) {
+    if (order.side == Side::BUY) {
+        execute_buy_market_order(order, slot);
     }
     else {
-        execute_sell_market_order(order);
+        execute_sell_market_order(order, slot);
     }
+    // Un ordre MARKET ne reste jamais au carnet : il est terminé (exécuté, reste abandonné ou rejeté)
+    release_node(slot);
 }
 
 // Exécute un ordre MARKET côté BUY
-void OrderBook::execute_buy_market_order(Order order) {
+void OrderBook::execute_buy_market_order(Order order, OrderSlot& slot) {
     uint64_t remaining_qty = order.quantity;
 
     // On parcourt les ordres SELL disponibles (meilleurs prix en premier)
-    while (remaining_qty > 0 && !sell_orders.empty()) {
-        auto& [price, order_queue] = *sell_orders.begin();
+    Price price;
+    OrderQueue* level;
+    while (remaining_qty > 0 && sell_orders.best(price, level)) {
+        OrderQueue& order_queue = *level;
         if (order_queue.empty()) {
-            sell_orders.erase(sell_orders.begin());
+            sell_orders.erase(price);
             continue;
         }
 
         Order& sell_order_ref = order_queue.front();
-        Order original_sell_order = sell_order_ref;
         // Quantité à exécuter
         uint64_t trade_qty = std::min(remaining_qty, sell_order_ref.quantity);
         uint64_t exec_timestamp = get_next_execution_timestamp(order.timestamp);
@@ -250,66 +365,59 @@ void OrderBook::execute_buy_market_order(Order order) {
         order_queue.update_quantity(trade_qty);
 
         // Enregistrement de l'exécution côté BUY
-        Order buy_execution = order_lookup[order.order_id];
+        ExecutionReport buy_execution = ExecutionReport::from_order(slot.node->order);
         buy_execution.timestamp = exec_timestamp;
         buy_execution.action = order.action;
         buy_execution.executed_quantity = trade_qty;
         buy_execution.execution_price = price;
-        buy_execution.counterparty_id = original_sell_order.order_id;
-        buy_execution.status = (remaining_qty == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        buy_execution.counterparty_id = sell_order_ref.order_id;
+        buy_execution.status = (remaining_qty == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         buy_execution.quantity = remaining_qty;
-        results.push_back(buy_execution);
-        record_execution(order, trade_qty);
+        emit(buy_execution);
+        record_execution(slot, trade_qty, remaining_qty);
 
         // Enregistrement de l'exécution côté SELL
-        Order sell_execution = original_sell_order;
+        ExecutionReport sell_execution = ExecutionReport::from_order(sell_order_ref);
         sell_execution.timestamp = exec_timestamp;
         sell_execution.executed_quantity = trade_qty;
         sell_execution.execution_price = price;
         sell_execution.counterparty_id = order.order_id;
-        sell_execution.status = (sell_order_ref.quantity == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        sell_execution.status = (sell_order_ref.quantity == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         sell_execution.quantity = sell_order_ref.quantity;
-        results.push_back(sell_execution);
-        record_execution(sell_execution, trade_qty);
-
-        // Si l'ordre SELL est terminé, on le retire
-        if (sell_order_ref.quantity == 0) {
-            order_lookup.erase(original_sell_order.order_id);
-            order_queue.pop();
-        }
+        emit(sell_execution);
+        fill_resting_order(order_queue, trade_qty);
 
         if (order_queue.empty()) {
-            sell_orders.erase(sell_orders.begin());
+            sell_orders.erase(price);
         }
     }
 
     if (order.quantity == remaining_qty) {
         // Si aucune exécution = rejet
-        Order rejected_order = order_lookup[order.order_id];
+        ExecutionReport rejected_order = ExecutionReport::from_order(slot.node->order);
         rejected_order.timestamp = get_next_execution_timestamp(order.timestamp);
         rejected_order.action = order.action;
-        rejected_order.status = "REJECTED";
-        rejected_order.executed_quantity = 0;
-        rejected_order.execution_price = 0.0;
-        rejected_order.counterparty_id = 0;
-        results.push_back(rejected_order);
+        rejected_order.status = Status::REJECTED;
+        slot.status = Status::REJECTED;
+        emit(rejected_order);
     }
 }
 
 // Exécute un ordre MARKET côté SELL
-void OrderBook::execute_sell_market_order(Order order) {
+void OrderBook::execute_sell_market_order(Order order, OrderSlot& slot) {
     uint64_t remaining_qty = order.quantity;
 
     // On parcourt les ordres BUY disponibles (meilleurs prix en premier)
-    while (remaining_qty > 0 && !buy_orders.empty()) {
-        auto& [price, order_queue] = *buy_orders.begin();
+    Price price;
+    OrderQueue* level;
+    while (remaining_qty > 0 && buy_orders.best(price, level)) {
+        OrderQueue& order_queue = *level;
         if (order_queue.empty()) {
-            buy_orders.erase(buy_orders.begin());
+            buy_orders.erase(price);
             continue;
         }
 
         Order& buy_order_ref = order_queue.front();
-        Order original_buy_order = buy_order_ref;
         uint64_t trade_qty = std::min(remaining_qty, buy_order_ref.quantity);
         uint64_t exec_timestamp = get_next_execution_timestamp(order.timestamp);
 
@@ -319,100 +427,90 @@ void OrderBook::execute_sell_market_order(Order order) {
         order_queue.update_quantity(trade_qty);
 
         // Enregistrement de l'exécution côté SELL
-        Order sell_execution = order_lookup[order.order_id];
+        ExecutionReport sell_execution = ExecutionReport::from_order(slot.node->order);
         sell_execution.timestamp = exec_timestamp;
         sell_execution.action = order.action;
         sell_execution.executed_quantity = trade_qty;
         sell_execution.execution_price = price;
-        sell_execution.counterparty_id = original_buy_order.order_id;
-        sell_execution.status = (remaining_qty == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        sell_execution.counterparty_id = buy_order_ref.order_id;
+        sell_execution.status = (remaining_qty == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         sell_execution.quantity = remaining_qty;
-        results.push_back(sell_execution);
-        record_execution(order, trade_qty);
+        emit(sell_execution);
+        record_execution(slot, trade_qty, remaining_qty);
 
         // Enregistrement de l'exécution côté BUY
-        Order buy_execution = original_buy_order;
+        ExecutionReport buy_execution = ExecutionReport::from_order(buy_order_ref);
         buy_execution.timestamp = exec_timestamp;
         buy_execution.executed_quantity = trade_qty;
         buy_execution.execution_price = price;
         buy_execution.counterparty_id = order.order_id;
-        buy_execution.status = (buy_order_ref.quantity == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        buy_execution.status = (buy_order_ref.quantity == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         buy_execution.quantity = buy_order_ref.quantity;
-        results.push_back(buy_execution);
-        record_execution(buy_execution, trade_qty);
-
-        if (buy_order_ref.quantity == 0) {
-            order_lookup.erase(original_buy_order.order_id);
-            order_queue.pop();
-        }
+        emit(buy_execution);
+        fill_resting_order(order_queue, trade_qty);
 
         if (order_queue.empty()) {
-            buy_orders.erase(buy_orders.begin());
+            buy_orders.erase(price);
         }
     }
 
     if (order.quantity == remaining_qty) {
         // No execution occurred
-        Order rejected_order = order_lookup[order.order_id];
+        ExecutionReport rejected_order = ExecutionReport::from_order(slot.node->order);
         rejected_order.timestamp = get_next_execution_timestamp(order.timestamp);
         rejected_order.action = order.action;
-        rejected_order.status = "REJECTED";
-        rejected_order.executed_quantity = 0;
-        rejected_order.execution_price = 0.0;
-        rejected_order.counterparty_id = 0;
-        results.push_back(rejected_order);
+        rejected_order.status = Status::REJECTED;
+        slot.status = Status::REJECTED;
+        emit(rejected_order);
     }
 }
 
 // Exécute un ordre LIMIT (BUY ou SELL)
-void OrderBook::execute_limit_order(Order order) {
-    if (order.side == "BUY") {
-        execute_buy_limit_order(order);
+void OrderBook::execute_limit_order(Order order, OrderSlot& slot) {
+    if (order.side == Side::BUY) {
+        execute_buy_limit_order(order, slot);
     }
     else {
-        execute_sell_limit_order(order);
+        execute_sell_limit_order(order, slot);
     }
 }
 
 // Exécute un ordre LIMIT côté BUY
-void OrderBook::execute_buy_limit_order(Order order) {
+void OrderBook::execute_buy_limit_order(Order order, OrderSlot& slot) {
     uint64_t remaining_qty = order.quantity;
 
     // Si l'ordre est NEW ou MODIFY, on vérifie s'il va matcher immédiatement
-    if (order.action == "NEW" || order.action == "MODIFY") {
+    if (order.action == Action::NEW || order.action == Action::MODIFY) {
         bool will_execute_immediately = false;
-        auto it = sell_orders.begin();
-        if (it != sell_orders.end() && it->first <= order.price && !it->second.empty()) {
+        Price best_price;
+        OrderQueue* best_level;
+        if (sell_orders.best(best_price, best_level) && best_price <= order.price && !best_level->empty()) {
             will_execute_immediately = true;
         }
         // Si pas de matching immédiat = PENDING
         if (!will_execute_immediately) {
-            Order pending_order = order_lookup[order.order_id];
+            ExecutionReport pending_order = ExecutionReport::from_order(slot.node->order);
             pending_order.timestamp = get_next_execution_timestamp(order.timestamp);
             pending_order.action = order.action;
-            pending_order.status = "PENDING";
-            pending_order.executed_quantity = 0;
-            pending_order.execution_price = 0.0;
-            pending_order.counterparty_id = 0;
-            results.push_back(pending_order);
+            pending_order.status = Status::PENDING;
+            emit(pending_order);
         }
     }
 
     // Matching avec les ordres SELL
-    auto it = sell_orders.begin();
-    while (it != sell_orders.end() && remaining_qty > 0) {
-        double sell_price = it->first;
+    Price sell_price;
+    OrderQueue* level;
+    while (remaining_qty > 0 && sell_orders.best(sell_price, level)) {
         // Prix trop élevé, on s'arrête
         if (sell_price > order.price) break;
 
-        OrderQueue& order_queue = it->second;
+        OrderQueue& order_queue = *level;
         if (order_queue.empty()) {
-            it = sell_orders.erase(it);
+            sell_orders.erase(sell_price);
             continue;
         }
 
         Order& sell_order_ref = order_queue.front();
-        Order original_sell_order = sell_order_ref;
         uint64_t trade_qty = std::min(remaining_qty, sell_order_ref.quantity);
         uint64_t exec_timestamp = get_next_execution_timestamp(order.timestamp);
 
@@ -422,90 +520,82 @@ void OrderBook::execute_buy_limit_order(Order order) {
         order_queue.update_quantity(trade_qty);
 
         // Execution BUY
-        Order buy_execution = order_lookup[order.order_id];
+        ExecutionReport buy_execution = ExecutionReport::from_order(slot.node->order);
         buy_execution.timestamp = exec_timestamp;
         buy_execution.action = order.action;
         buy_execution.executed_quantity = trade_qty;
         buy_execution.execution_price = sell_price;
-        buy_execution.counterparty_id = original_sell_order.order_id;
-        buy_execution.status = (remaining_qty == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        buy_execution.counterparty_id = sell_order_ref.order_id;
+        buy_execution.status = (remaining_qty == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         buy_execution.quantity = remaining_qty;
-        results.push_back(buy_execution);
-        record_execution(order, trade_qty);
+        emit(buy_execution);
+        record_execution(slot, trade_qty, remaining_qty);
 
         // Execution SELL
-        Order sell_execution = original_sell_order;
+        ExecutionReport sell_execution = ExecutionReport::from_order(sell_order_ref);
         sell_execution.timestamp = exec_timestamp;
         sell_execution.executed_quantity = trade_qty;
         sell_execution.execution_price = sell_price;
         sell_execution.counterparty_id = order.order_id;
-        sell_execution.status = (sell_order_ref.quantity == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        sell_execution.status = (sell_order_ref.quantity == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         sell_execution.quantity = sell_order_ref.quantity;
-        results.push_back(sell_execution);
-        record_execution(sell_execution, trade_qty);
-
-        // Si quantité restante, on le place dans le carnet BUY
-        if (sell_order_ref.quantity == 0) {
-            order_lookup.erase(original_sell_order.order_id);
-            order_queue.pop();
-        }
+        emit(sell_execution);
+        fill_resting_order(order_queue, trade_qty);
 
         if (order_queue.empty()) {
-            it = sell_orders.erase(it);
-        }
-        else {
+            sell_orders.erase(sell_price);
         }
     }
 
     if (remaining_qty > 0) {
-        Order remaining_order = order_lookup[order.order_id];
-        remaining_order.quantity = remaining_qty;
-        remaining_order.price = order.price;
+        OrderNode& remaining_node = *slot.node;
+        remaining_node.order.quantity = remaining_qty;
+        remaining_node.order.price = order.price;
 
-        buy_orders[order.price].add_order(remaining_order);
-        order_lookup[order.order_id] = remaining_order;
+        buy_orders.get_or_create(order.price).add_order(&remaining_node);
+    }
+    else {
+        // Exécuté entièrement à son arrivée : ordre terminé
+        release_node(slot);
     }
 }
 
 // Exécute un ordre LIMIT côté SELL
-void OrderBook::execute_sell_limit_order(Order order) {
+void OrderBook::execute_sell_limit_order(Order order, OrderSlot& slot) {
     uint64_t remaining_qty = order.quantity;
 
     // Si l'ordre est NEW ou MODIFY, on vérifie s'il va matcher immédiatement
-    if (order.action == "NEW" || order.action == "MODIFY") {
+    if (order.action == Action::NEW || order.action == Action::MODIFY) {
         bool will_execute_immediately = false;
-        auto it = buy_orders.begin();
-        if (it != buy_orders.end() && it->first >= order.price && !it->second.empty()) {
+        Price best_price;
+        OrderQueue* best_level;
+        if (buy_orders.best(best_price, best_level) && best_price >= order.price && !best_level->empty()) {
             will_execute_immediately = true;
         }
         // Si pas de matching immédiat = PENDING
         if (!will_execute_immediately) {
-            Order pending_order = order_lookup[order.order_id];
+            ExecutionReport pending_order = ExecutionReport::from_order(slot.node->order);
             pending_order.timestamp = get_next_execution_timestamp(order.timestamp);
             pending_order.action = order.action;
-            pending_order.status = "PENDING";
-            pending_order.executed_quantity = 0;
-            pending_order.execution_price = 0.0;
-            pending_order.counterparty_id = 0;
-            results.push_back(pending_order);
+            pending_order.status = Status::PENDING;
+            emit(pending_order);
         }
     }
 
     // Matching avec les ordres BUY
-    auto it = buy_orders.begin();
-    while (it != buy_orders.end() && remaining_qty > 0) {
-        double buy_price = it->first;
+    Price buy_price;
+    OrderQueue* level;
+    while (remaining_qty > 0 && buy_orders.best(buy_price, level)) {
         // Prix trop bas, on s'arrête
         if (buy_price < order.price) break;
 
-        OrderQueue& order_queue = it->second;
+        OrderQueue& order_queue = *level;
         if (order_queue.empty()) {
-            it = buy_orders.erase(it);
+            buy_orders.erase(buy_price);
             continue;
         }
 
         Order& buy_order_ref = order_queue.front();
-        Order original_buy_order = buy_order_ref;
         uint64_t trade_qty = std::min(remaining_qty, buy_order_ref.quantity);
         uint64_t exec_timestamp = get_next_execution_timestamp(order.timestamp);
 
@@ -515,97 +605,66 @@ void OrderBook::execute_sell_limit_order(Order order) {
         order_queue.update_quantity(trade_qty);
 
         // Execution SELL
-        Order sell_execution = order_lookup[order.order_id];
+        ExecutionReport sell_execution = ExecutionReport::from_order(slot.node->order);
         sell_execution.timestamp = exec_timestamp;
         sell_execution.action = order.action;
         sell_execution.executed_quantity = trade_qty;
         sell_execution.execution_price = buy_price;
-        sell_execution.counterparty_id = original_buy_order.order_id;
-        sell_execution.status = (remaining_qty == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        sell_execution.counterparty_id = buy_order_ref.order_id;
+        sell_execution.status = (remaining_qty == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         sell_execution.quantity = remaining_qty;
-        results.push_back(sell_execution);
-        record_execution(order, trade_qty);
+        emit(sell_execution);
+        record_execution(slot, trade_qty, remaining_qty);
 
         // Execution BUY
-        Order buy_execution = original_buy_order;
+        ExecutionReport buy_execution = ExecutionReport::from_order(buy_order_ref);
         buy_execution.timestamp = exec_timestamp;
         buy_execution.executed_quantity = trade_qty;
         buy_execution.execution_price = buy_price;
         buy_execution.counterparty_id = order.order_id;
-        buy_execution.status = (buy_order_ref.quantity == 0) ? "EXECUTED" : "PARTIALLY_EXECUTED";
+        buy_execution.status = (buy_order_ref.quantity == 0) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
         buy_execution.quantity = buy_order_ref.quantity;
-        results.push_back(buy_execution);
-        record_execution(buy_execution, trade_qty);
-
-        if (buy_order_ref.quantity == 0) {
-            order_lookup.erase(original_buy_order.order_id);
-            order_queue.pop();
-        }
+        emit(buy_execution);
+        fill_resting_order(order_queue, trade_qty);
 
         if (order_queue.empty()) {
-            it = buy_orders.erase(it);
-        }
-        else {
+            buy_orders.erase(buy_price);
         }
     }
 
     if (remaining_qty > 0) {
-        Order remaining_order = order_lookup[order.order_id];
-        remaining_order.quantity = remaining_qty;
-        remaining_order.price = order.price;
+        OrderNode& remaining_node = *slot.node;
+        remaining_node.order.quantity = remaining_qty;
+        remaining_node.order.price = order.price;
 
-        sell_orders[order.price].add_order(remaining_order);
-        order_lookup[order.order_id] = remaining_order;
+        sell_orders.get_or_create(order.price).add_order(&remaining_node);
+    }
+    else {
+        // Exécuté entièrement à son arrivée : ordre terminé
+        release_node(slot);
     }
 }
 
-// Retire un ordre du carnet (BUY ou SELL)
-void OrderBook::cancel_order_from_book(const Order& order) {
-    // Côté BUY
-    if (order.side == "BUY") {
-        auto price_it = buy_orders.find(order.price);
-        if (price_it != buy_orders.end()) {
-            std::queue<Order> new_queue;
-            uint64_t new_total_quantity = 0;
-            while (!price_it->second.orders.empty()) {
-                Order& o = price_it->second.front();
-                if (o.order_id != order.order_id) {
-                    new_queue.push(o);
-                    new_total_quantity += o.quantity;
-                }
-                price_it->second.pop();
-            }
-            price_it->second.orders = new_queue;
-            price_it->second.total_quantity = new_total_quantity;
-
-            if (price_it->second.empty()) {
-                buy_orders.erase(price_it);
-            }
-        }
+// Retire un ordre du carnet (BUY ou SELL) en temps constant
+void OrderBook::cancel_order_from_book(OrderNode& node) {
+    OrderQueue* level = node.level;
+    // Ordre absent du carnet (déjà exécuté ou jamais placé)
+    if (level == nullptr) {
+        return;
     }
-    // Côté SELL
-    else {
-        auto price_it = sell_orders.find(order.price);
-        if (price_it != sell_orders.end()) {
-            std::queue<Order> new_queue;
-            uint64_t new_total_quantity = 0;
-            while (!price_it->second.orders.empty()) {
-                Order& o = price_it->second.front();
-                if (o.order_id != order.order_id) {
-                    new_queue.push(o);
-                    new_total_quantity += o.quantity;
-                }
-                price_it->second.pop();
-            }
-            price_it->second.orders = new_queue;
-            price_it->second.total_quantity = new_total_quantity;
-
-            if (price_it->second.empty()) {
-                sell_orders.erase(price_it);
-            }
+
+    level->remove(&node);
+
+    // Supprime la limite de prix si elle est vide
+    if (level->empty()) {
+        if (node.order.side == Side::BUY) {
+            buy_orders.erase(node.order.price);
+        }
+        else {
+            sell_orders.erase(node.order.price);
         }
     }
 }
 
 
-#endif // ORDER_BOOK_H
\ No newline at end of file
+#endif // ORDER_BOOK_H
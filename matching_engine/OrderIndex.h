@@ -0,0 +1,243 @@
+#ifndef ORDER_INDEX_H
+#define ORDER_INDEX_H
+
+#include "Order.h"
+#include "PriceLevels.h"
+#include "MemoryPool.h"
+#include "TombstoneSet.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+// Entrée de l'index : tout ce que le carnet sait d'un ordre identifié par son ID
+struct OrderSlot {
+    uint64_t order_id;
+    uint64_t total_executed;    // Quantité exécutée cumulée (utile pour MODIFY)
+    OrderNode* node;            // Noeud de l'ordre (nullptr une fois terminé : exécuté, annulé ou MARKET traité)
+    Status status;              // Dernier statut publié (NONE = case libre)
+    SymbolId instrument;        // Carnet de l'ordre (index partagé par les carnets d'un moteur)
+
+    OrderSlot() : order_id(0), total_executed(0), node(nullptr), status(Status::NONE), instrument(0) {}
+};
+
+static_assert(sizeof(OrderSlot) == 32, "OrderSlot must stay two per cache line");
+
+// Index des ordres par ID : table à adressage ouvert (sondage linéaire Robin Hood) dans une arène.
+// Un moteur partage le sien entre ses carnets : c'est l'unique détection des doublons d'ID.
+// Il n'y a pas de suppression. Avec la rétention (set_retention), les entrées d'ordres terminés (sans
+// noeud : annulés, exécutés entièrement, ordres MARKET) quittent la table quand elle est pleine et leurs IDs passent dans
+// un TombstoneSet, qui suffit à rejeter un doublon : la table reste à la taille des ordres vivants.
+// Une insertion peut déplacer (ou retirer) les entrées : ne pas conserver de pointeur d'entrée à travers un insert.
+class OrderIndex {
+private:
+    std::vector<OrderSlot, PoolAllocator<OrderSlot>> slots;
+    size_t mask;
+    int shift;
+    size_t count;
+    // IDs retirés de la table (rétention active)
+    TombstoneSet tombstones;
+    bool retire_terminal;
+    // Capacité réservée, en dessous de laquelle une compaction ne réduit pas la table
+    size_t reserved_capacity;
+
+    // Hachage multiplicatif (Fibonacci) : disperse les IDs séquentiels
+    size_t home(uint64_t order_id) const {
+        return static_cast<size_t>((order_id * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+    size_t distance(size_t position, uint64_t order_id) const {
+        return (position - home(order_id)) & mask;
+    }
+    static bool is_terminal(const OrderSlot& slot) { return slot.status != Status::NONE && slot.node == nullptr; }
+    void rehash(size_t capacity);
+    void grow_if_full() {
+        if ((count + 1) * 4 > slots.size() * 3) make_room();
+    }
+    // Table pleine : double sa capacité, ou la compacte si assez d'entrées terminées peuvent être retirées
+    void make_room();
+    // Retire les entrées terminées vers les tombes sans changer de tableau (suppressions par décalage arrière)
+    void compact();
+    // Place un ID absent à partir de `position`, à `dist` de son origine (déplacements Robin Hood)
+    OrderSlot& insert_at(size_t position, size_t dist, uint64_t order_id);
+
+public:
+    explicit OrderIndex(BookArena& arena)
+        : slots(PoolAllocator<OrderSlot>(&arena)), mask(0), shift(64), count(0), tombstones(arena),
+          retire_terminal(false), reserved_capacity(0) {}
+
+    // Entrées présentes dans la table (hors IDs retirés)
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return slots.size(); }
+
+    // Active le retrait des ordres terminés vers les tombes (désactivé par défaut)
+    void set_retention(bool enabled) { retire_terminal = enabled; }
+
+    // IDs retirés de la table
+    size_t retired_count() const { return tombstones.size(); }
+
+    // Mémoire occupée par la table et par les tombes, en octets
+    size_t table_bytes() const { return slots.capacity() * sizeof(OrderSlot); }
+    size_t tombstone_bytes() const { return tombstones.memory_bytes(); }
+
+    // Prépare la table pour `orders` IDs sans agrandissement
+    void reserve(size_t orders);
+
+    // Précharge la case d'origine d'un ID (avant un find ou un insert proche)
+    void prefetch(uint64_t order_id) const {
+        if (!slots.empty()) __builtin_prefetch(&slots[home(order_id)]);
+    }
+
+    // Cherche l'entrée d'un ID (nullptr si inconnu ou retiré)
+    OrderSlot* find(uint64_t order_id);
+
+    // Insère un ID absent de l'index et retourne son entrée (statut PENDING, rien d'exécuté)
+    OrderSlot& insert(uint64_t order_id);
+
+    // Entrée de l'ID, insérée si absente (`inserted` l'indique) : un seul sondage pour un nouvel ID.
+    // nullptr (sans insertion) si l'ID a été retiré.
+    OrderSlot* find_or_insert(uint64_t order_id, bool& inserted);
+};
+
+// Implémentation
+
+void OrderIndex::reserve(size_t orders) {
+    // Facteur de charge maximal : 3/4
+    size_t capacity = 16;
+    while (capacity * 3 < orders * 4) capacity *= 2;
+    reserved_capacity = std::max(reserved_capacity, capacity);
+    if (capacity > slots.size()) rehash(capacity);
+}
+
+void OrderIndex::make_room() {
+    if (slots.empty()) {
+        rehash(16);
+        return;
+    }
+    size_t kept = count;
+    if (retire_terminal) {
+        kept = 0;
+        for (const OrderSlot& slot : slots) {
+            if (slot.status != Status::NONE && !is_terminal(slot)) kept++;
+        }
+    }
+    // Charge d'au plus 3/8 après compaction : au pire (rien à retirer), la capacité double
+    size_t capacity = std::max<size_t>(16, reserved_capacity);
+    while (capacity * 3 < (kept + 1) * 8) capacity *= 2;
+    // Hystérésis : si la table actuelle suffit après retrait, elle est compactée sur place, sans allocation ;
+    // elle n'est réduite que lorsqu'elle fait plus de 4 fois la taille nécessaire
+    if (retire_terminal && capacity <= slots.size() && capacity * 4 > slots.size()) {
+        compact();
+    } else {
+        rehash(capacity);
+    }
+}
+
+void OrderIndex::compact() {
+    for (size_t position = 0; position < slots.size();) {
+        if (!is_terminal(slots[position])) {
+            ++position;
+            continue;
+        }
+        tombstones.insert(slots[position].order_id);
+        count--;
+        // Les entrées suivantes de la grappe, hors de leur case d'origine, reculent d'une case ;
+        // `position` est réexaminée puisqu'elle a pu en recevoir une
+        size_t hole = position;
+        size_t next = (hole + 1) & mask;
+        while (slots[next].status != Status::NONE && distance(next, slots[next].order_id) > 0) {
+            slots[hole] = slots[next];
+            hole = next;
+            next = (next + 1) & mask;
+        }
+        slots[hole] = OrderSlot();
+    }
+}
+
+void OrderIndex::rehash(size_t capacity) {
+    std::vector<OrderSlot, PoolAllocator<OrderSlot>> old(slots.get_allocator());
+    old.swap(slots);
+    slots.resize(capacity);
+    mask = capacity - 1;
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) shift--;
+    count = 0;
+
+    for (const OrderSlot& slot : old) {
+        if (slot.status == Status::NONE) continue;
+        if (retire_terminal && is_terminal(slot)) {
+            tombstones.insert(slot.order_id);
+        } else {
+            insert(slot.order_id) = slot;
+        }
+    }
+}
+
+OrderSlot* OrderIndex::find(uint64_t order_id) {
+    if (count == 0) return nullptr;
+    size_t position = home(order_id);
+    for (size_t dist = 0;; ++dist) {
+        OrderSlot& slot = slots[position];
+        // Case libre ou entrée plus proche de son origine : l'ID n'est pas présent
+        if (slot.status == Status::NONE || distance(position, slot.order_id) < dist) {
+            return nullptr;
+        }
+        if (slot.order_id == order_id) {
+            return &slot;
+        }
+        position = (position + 1) & mask;
+    }
+}
+
+OrderSlot& OrderIndex::insert(uint64_t order_id) {
+    grow_if_full();
+    return insert_at(home(order_id), 0, order_id);
+}
+
+OrderSlot* OrderIndex::find_or_insert(uint64_t order_id, bool& inserted) {
+    grow_if_full();
+    size_t position = home(order_id);
+    size_t dist = 0;
+    // Même parcours que find : s'arrête sur l'ID ou là où il serait placé
+    for (;; ++dist) {
+        OrderSlot& slot = slots[position];
+        if (slot.status == Status::NONE || distance(position, slot.order_id) < dist) break;
+        if (slot.order_id == order_id) {
+            inserted = false;
+            return &slot;
+        }
+        position = (position + 1) & mask;
+    }
+    if (tombstones.contains(order_id)) {
+        inserted = false;
+        return nullptr;
+    }
+    inserted = true;
+    return &insert_at(position, dist, order_id);
+}
+
+OrderSlot& OrderIndex::insert_at(size_t position, size_t dist, uint64_t order_id) {
+    count++;
+
+    OrderSlot entry;
+    entry.order_id = order_id;
+    entry.status = Status::PENDING;
+    OrderSlot* placed = nullptr;
+
+    for (;; ++dist) {
+        OrderSlot& slot = slots[position];
+        if (slot.status == Status::NONE) {
+            slot = entry;
+            return placed ? *placed : slot;
+        }
+        // Robin Hood : l'entrée la plus éloignée de son origine prend la place
+        size_t existing = distance(position, slot.order_id);
+        if (existing < dist) {
+            std::swap(slot, entry);
+            if (placed == nullptr) placed = &slot;
+            dist = existing;
+        }
+        position = (position + 1) & mask;
+    }
+}
+
+#endif // ORDER_INDEX_H
@@ -0,0 +1,257 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "Order.h"
+#include "ExecutionReport.h"
+#include "ResultSink.h"
+#include "SymbolTable.h"
+#include "CSVParser.h"
+#include "BinaryOrders.h"
+#include "SpscRing.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <exception>
+
+// Temps d'un étage du pipeline : travail effectif et attente sur les files
+struct StageTimes {
+    double busy_ms = 0;
+    double idle_ms = 0;
+};
+
+// Exécution en pipeline : lecture, matching et écriture sur trois threads, reliés par des files SPSC
+// de lots. Les lots circulent entre un nombre fixe de tampons recyclés : la mémoire est bornée par
+// la capacité des files et non par la taille du fichier.
+// Le thread d'écriture formate avec son propre miroir de la table des instruments, tenu à jour par
+// les nouveaux instruments et textes bruts transmis avec chaque lot (aucun accès partagé à `symbols`).
+class MatchingPipeline {
+private:
+    // Ajouts à la table des instruments depuis le lot précédent
+    struct SymbolDelta {
+        std::vector<std::string> names;
+        std::vector<RawFields> raw_fields;
+
+        void clear() {
+            names.clear();
+            raw_fields.clear();
+        }
+    };
+
+    struct OrderBatch {
+        std::vector<Order> orders;
+        SymbolDelta symbols;
+        bool last = false;
+    };
+
+    struct ReportBatch {
+        std::vector<ExecutionReport> reports;
+        SymbolDelta symbols;
+        bool last = false;
+    };
+
+    // Sink du moteur : remplit le lot d'événements en cours (thread de matching)
+    class BatchSink : public ResultSink {
+    public:
+        ReportBatch* batch = nullptr;
+        void on_report(const ExecutionReport& report) override { batch->reports.push_back(report); }
+    };
+
+    SymbolTable& symbols;
+    SymbolTable output_table;
+    size_t batch_size;
+
+    std::vector<std::unique_ptr<OrderBatch>> order_batches;
+    std::vector<std::unique_ptr<ReportBatch>> report_batches;
+    SpscRing<OrderBatch*> free_orders;      // matching -> lecture
+    SpscRing<OrderBatch*> filled_orders;    // lecture -> matching
+    SpscRing<ReportBatch*> free_reports;    // écriture -> matching
+    SpscRing<ReportBatch*> filled_reports;  // matching -> écriture
+    BatchSink batch_sink;
+
+    StageTimes reader;
+    StageTimes matcher;
+    StageTimes writer;
+    uint64_t orders_read;
+    uint64_t orders_rejected;
+
+    template <typename T>
+    static void push_wait(SpscRing<T*>& ring, T* item, double& idle_ms);
+    template <typename T>
+    static T* pop_wait(SpscRing<T*>& ring, double& idle_ms);
+    static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void read_stage(const std::string& input_file, size_t parse_threads, bool& opened, std::exception_ptr& failure);
+    void write_stage(ResultSink& output);
+
+public:
+    // batches : nombre de lots en circulation par file
+    explicit MatchingPipeline(SymbolTable& symbol_table, size_t orders_per_batch = 4096, size_t batches = 8);
+
+    MatchingPipeline(const MatchingPipeline&) = delete;
+    MatchingPipeline& operator=(const MatchingPipeline&) = delete;
+
+    // Table des instruments du thread d'écriture (à donner au sink de sortie)
+    const SymbolTable& output_symbols() const { return output_table; }
+
+    // Sink à brancher sur le moteur : les événements rejoignent le lot en cours
+    ResultSink& engine_sink() { return batch_sink; }
+
+    // Lit `input_file`, appelle `process(orders, count)` pour chaque lot d'ordres puis `finish()` sur le thread appelant,
+    // et transmet les événements du moteur à `output` sur le thread d'écriture.
+    // Retourne false si le fichier ne peut pas être ouvert ; une exception de lecture est relancée
+    // après traitement des ordres qui la précèdent.
+    template <typename Process, typename Finish>
+    bool run(const std::string& input_file, size_t parse_threads, ResultSink& output,
+             Process process, Finish finish);
+
+    const StageTimes& reader_times() const { return reader; }
+    const StageTimes& matcher_times() const { return matcher; }
+    const StageTimes& writer_times() const { return writer; }
+    uint64_t order_count() const { return orders_read; }
+    uint64_t rejected_count() const { return orders_rejected; }
+};
+
+// Implémentation
+
+MatchingPipeline::MatchingPipeline(SymbolTable& symbol_table, size_t orders_per_batch, size_t batches)
+    : symbols(symbol_table), batch_size(orders_per_batch),
+      free_orders(batches), filled_orders(batches), free_reports(batches), filled_reports(batches),
+      orders_read(0), orders_rejected(0) {
+    for (size_t i = 0; i < batches; ++i) {
+        order_batches.emplace_back(new OrderBatch());
+        order_batches.back()->orders.reserve(batch_size);
+        free_orders.try_push(order_batches.back().get());
+        report_batches.emplace_back(new ReportBatch());
+        free_reports.try_push(report_batches.back().get());
+    }
+}
+
+template <typename T>
+void MatchingPipeline::push_wait(SpscRing<T*>& ring, T* item, double& idle_ms) {
+    if (ring.try_push(item)) return;
+    auto start = std::chrono::steady_clock::now();
+    while (!ring.try_push(item)) std::this_thread::yield();
+    idle_ms += elapsed_ms(start);
+}
+
+template <typename T>
+T* MatchingPipeline::pop_wait(SpscRing<T*>& ring, double& idle_ms) {
+    T* item = nullptr;
+    if (ring.try_pop(item)) return item;
+    auto start = std::chrono::steady_clock::now();
+    while (!ring.try_pop(item)) std::this_thread::yield();
+    idle_ms += elapsed_ms(start);
+    return item;
+}
+
+void MatchingPipeline::read_stage(const std::string& input_file, size_t parse_threads, bool& opened,
+                                  std::exception_ptr& failure) {
+    auto start = std::chrono::steady_clock::now();
+    size_t published_names = symbols.size();
+    size_t published_raw_fields = symbols.raw_fields_count();
+    OrderBatch* batch = pop_wait(free_orders, reader.idle_ms);
+
+    // Joint au lot les instruments et textes bruts créés depuis le lot précédent, puis le publie
+    auto publish = [&](bool last) {
+        batch->symbols.clear();
+        for (; published_names < symbols.size(); ++published_names) {
+            batch->symbols.names.push_back(symbols.name(static_cast<SymbolId>(published_names)));
+        }
+        for (; published_raw_fields < symbols.raw_fields_count(); ++published_raw_fields) {
+            batch->symbols.raw_fields.push_back(symbols.get_raw_fields(static_cast<uint32_t>(published_raw_fields)));
+        }
+        batch->last = last;
+        push_wait(filled_orders, batch, reader.idle_ms);
+        if (!last) batch = pop_wait(free_orders, reader.idle_ms);
+    };
+
+    try {
+        opened = BinaryOrderFile::for_each_order(input_file, symbols, [&](const Order& order) {
+            orders_read++;
+            if (order.status == Status::REJECTED) orders_rejected++;
+            batch->orders.push_back(order);
+            if (batch->orders.size() >= batch_size) publish(false);
+        }, parse_threads);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    publish(true);
+    reader.busy_ms = elapsed_ms(start) - reader.idle_ms;
+}
+
+void MatchingPipeline::write_stage(ResultSink& output) {
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        ReportBatch* batch = pop_wait(filled_reports, writer.idle_ms);
+        // Même ordre d'ajout que la table du lecteur : mêmes identifiants et références
+        for (const std::string& name : batch->symbols.names) {
+            output_table.intern(name);
+        }
+        for (const RawFields& raw : batch->symbols.raw_fields) {
+            output_table.store_raw_fields(raw.side, raw.type, raw.action);
+        }
+        for (const ExecutionReport& report : batch->reports) {
+            output.on_report(report);
+        }
+        bool last = batch->last;
+        batch->reports.clear();
+        push_wait(free_reports, batch, writer.idle_ms);
+        if (last) break;
+    }
+    output.flush();
+    writer.busy_ms = elapsed_ms(start) - writer.idle_ms;
+}
+
+template <typename Process, typename Finish>
+bool MatchingPipeline::run(const std::string& input_file, size_t parse_threads, ResultSink& output,
+                           Process process, Finish finish) {
+    // Le miroir part de l'état courant (instruments et tailles de tick configurés)
+    output_table = symbols.snapshot_instruments();
+    for (size_t ref = 1; ref < symbols.raw_fields_count(); ++ref) {
+        const RawFields& raw = symbols.get_raw_fields(static_cast<uint32_t>(ref));
+        output_table.store_raw_fields(raw.side, raw.type, raw.action);
+    }
+
+    bool opened = false;
+    std::exception_ptr read_failure;
+    std::exception_ptr match_failure;
+    std::thread read_thread([&]() { read_stage(input_file, parse_threads, opened, read_failure); });
+    std::thread write_thread([&]() { write_stage(output); });
+
+    // Étage de matching sur le thread appelant
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        OrderBatch* orders = pop_wait(filled_orders, matcher.idle_ms);
+        ReportBatch* reports = pop_wait(free_reports, matcher.idle_ms);
+        batch_sink.batch = reports;
+        // Après une erreur, les lots restants sont seulement vidés pour arrêter les autres étages
+        if (!match_failure) {
+            try {
+                process(orders->orders.data(), orders->orders.size());
+                if (orders->last) finish();
+            } catch (...) {
+                match_failure = std::current_exception();
+            }
+        }
+        std::swap(reports->symbols, orders->symbols);
+        reports->last = orders->last;
+        orders->orders.clear();
+        push_wait(free_orders, orders, matcher.idle_ms);
+        push_wait(filled_reports, reports, matcher.idle_ms);
+        if (reports->last) break;
+    }
+    batch_sink.batch = nullptr;
+    matcher.busy_ms = elapsed_ms(start) - matcher.idle_ms;
+
+    read_thread.join();
+    write_thread.join();
+    if (read_failure) std::rethrow_exception(read_failure);
+    if (match_failure) std::rethrow_exception(match_failure);
+    return opened;
+}
+
+#endif // PIPELINE_H
@@ -0,0 +1,141 @@
+#ifndef PRICE_H
+#define PRICE_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <charconv>
+
+// Prix en virgule fixe : nombre entier de ticks de l'instrument
+using Price = int64_t;
+
+// Taille de tick décimale : units * 10^-decimals (ex : 0.01 = {1, 2}, 0.05 = {5, 2})
+struct TickSize {
+    int64_t units;
+    int decimals;
+
+    TickSize() : units(1), decimals(2) {}
+    TickSize(int64_t u, int d) : units(u), decimals(d) {}
+
+    // Convertit un prix décimal (déjà validé par Validator::is_valid_number) en ticks,
+    // arrondi au tick le plus proche. Retourne false en cas de dépassement.
+    bool to_ticks(std::string_view str, Price& ticks) const;
+
+    // Écrit un prix en ticks sous forme décimale (au moins 2 décimales)
+    void write(std::ostream& os, Price ticks) const;
+    // Même écriture dans un tampon d'au moins max_formatted_size octets ; retourne la fin du texte
+    char* format(char* out, Price ticks) const;
+    // Signe, 20 chiffres entiers, point et 18 décimales au plus
+    static constexpr size_t max_formatted_size = 40;
+
+    // Lit une taille de tick décimale strictement positive (ex : "0.05")
+    static bool parse(const std::string& str, TickSize& tick);
+};
+
+// Implémentation
+
+bool TickSize::to_ticks(std::string_view str, Price& ticks) const {
+    const int64_t max_value = std::numeric_limits<int64_t>::max();
+    size_t i = 0;
+    bool negative = false;
+    if (i < str.size() && (str[i] == '-' || str[i] == '+')) {
+        negative = (str[i] == '-');
+        i++;
+    }
+
+    // Valeur entière en unités de 10^-decimals
+    int64_t scaled = 0;
+    int fraction_digits = -1;
+    bool round_up = false;
+    for (; i < str.size(); ++i) {
+        char c = str[i];
+        if (c == '.') {
+            fraction_digits = 0;
+            continue;
+        }
+        if (fraction_digits >= decimals) {
+            // Premier chiffre au-delà de la précision : décide de l'arrondi
+            if (fraction_digits == decimals) round_up = (c >= '5');
+            fraction_digits++;
+            continue;
+        }
+        if (scaled > (max_value - 9) / 10) return false;
+        scaled = scaled * 10 + (c - '0');
+        if (fraction_digits >= 0) fraction_digits++;
+    }
+
+    // Complète les décimales manquantes
+    for (int d = (fraction_digits < 0 ? 0 : fraction_digits); d < decimals; ++d) {
+        if (scaled > max_value / 10) return false;
+        scaled *= 10;
+    }
+    if (round_up) scaled++;
+
+    // Arrondi au multiple de tick le plus proche
+    int64_t result = scaled / units;
+    if (2 * (scaled % units) >= units) result++;
+
+    ticks = negative ? -result : result;
+    return true;
+}
+
+void TickSize::write(std::ostream& os, Price ticks) const {
+    char text[max_formatted_size];
+    os.write(text, format(text, ticks) - text);
+}
+
+char* TickSize::format(char* out, Price ticks) const {
+    uint64_t magnitude = (ticks < 0) ? (0 - static_cast<uint64_t>(ticks)) : static_cast<uint64_t>(ticks);
+    magnitude *= static_cast<uint64_t>(units);
+
+    int shown_decimals = decimals < 2 ? 2 : decimals;
+    uint64_t scale = 1;
+    for (int d = 0; d < decimals; ++d) scale *= 10;
+
+    if (ticks < 0) *out++ = '-';
+    out = std::to_chars(out, out + 20, magnitude / scale).ptr;
+    *out++ = '.';
+
+    // Partie fractionnaire complétée par des zéros à droite
+    uint64_t fraction = magnitude % scale;
+    for (int d = decimals - 1; d >= 0; --d) {
+        out[d] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    for (int d = decimals; d < shown_decimals; ++d) out[d] = '0';
+    return out + shown_decimals;
+}
+
+bool TickSize::parse(const std::string& str, TickSize& tick) {
+    int64_t units = 0;
+    int decimals = 0;
+    bool has_dot = false;
+    bool has_digit = false;
+
+    for (char c : str) {
+        if (c == '.' && !has_dot) {
+            has_dot = true;
+        } else if (c >= '0' && c <= '9') {
+            if (units > (std::numeric_limits<int64_t>::max() - 9) / 10 || decimals >= 18) return false;
+            units = units * 10 + (c - '0');
+            if (has_dot) decimals++;
+            has_digit = true;
+        } else {
+            return false;
+        }
+    }
+    if (!has_digit || units == 0) return false;
+
+    // Normalise les zéros de fin (0.10 -> {1, 1})
+    while (decimals > 0 && units % 10 == 0) {
+        units /= 10;
+        decimals--;
+    }
+
+    tick = TickSize(units, decimals);
+    return true;
+}
+
+#endif // PRICE_H
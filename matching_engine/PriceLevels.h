@@ -0,0 +1,303 @@
+#ifndef PRICE_LEVELS_H
+#define PRICE_LEVELS_H
+
+#include "Order.h"
+#include "MemoryPool.h"
+#include <map>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <limits>
+
+struct OrderQueue;
+
+// Noeud intrusif : un ordre connu du carnet, chaîné dans sa file de prix s'il est au repos
+struct OrderNode {
+    Order order;
+    OrderNode* prev;
+    OrderNode* next;
+    OrderQueue* level;          // File de prix courante (nullptr si hors carnet)
+
+    OrderNode() : prev(nullptr), next(nullptr), level(nullptr) {}
+};
+
+// File d'attente d'ordres pour une même limite de prix (liste doublement chaînée FIFO)
+struct OrderQueue {
+    OrderNode* head;
+    OrderNode* tail;
+    uint64_t total_quantity;
+
+    OrderQueue() : head(nullptr), tail(nullptr), total_quantity(0) {}
+
+    // Les noeuds pointent vers leur file : elle ne doit pas être déplacée
+    OrderQueue(const OrderQueue&) = delete;
+    OrderQueue& operator=(const OrderQueue&) = delete;
+
+    void add_order(OrderNode* node) {
+        node->prev = tail;
+        node->next = nullptr;
+        node->level = this;
+        if (tail) tail->next = node;
+        else head = node;
+        tail = node;
+        total_quantity += node->order.quantity;
+    }
+
+    bool empty() const {
+        return head == nullptr;
+    }
+
+    Order& front() {
+        return head->order;
+    }
+
+    void pop() {
+        if (head) {
+            remove(head);
+        }
+    }
+
+    // Retire un noeud en O(1) sans toucher à la priorité des autres ordres
+    void remove(OrderNode* node) {
+        if (node->prev) node->prev->next = node->next;
+        else head = node->next;
+        if (node->next) node->next->prev = node->prev;
+        else tail = node->prev;
+        total_quantity -= node->order.quantity;
+        node->prev = nullptr;
+        node->next = nullptr;
+        node->level = nullptr;
+    }
+
+    void update_quantity(uint64_t executed_qty) {
+        total_quantity -= executed_qty;
+    }
+
+    // Reprend tous les ordres d'une autre file (priorité conservée)
+    void take_from(OrderQueue& other) {
+        head = other.head;
+        tail = other.tail;
+        total_quantity = other.total_quantity;
+        for (OrderNode* node = head; node != nullptr; node = node->next) {
+            node->level = this;
+        }
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.total_quantity = 0;
+    }
+};
+
+// Limites de prix d'un côté du carnet.
+// Les prix proches du meilleur prix sont rangés dans une échelle contiguë indexée par tick
+// (fenêtre [anchor, anchor + capacity)), avec un bitmap d'occupation à deux niveaux pour
+// trouver la meilleure limite en quelques instructions ctz/clz. Les prix hors fenêtre sont
+// rangés dans un arbre. Avec une capacité nulle, seul l'arbre est utilisé.
+template <typename Compare>
+class PriceLevels {
+private:
+    // BUY : meilleur prix = plus haut ; SELL : meilleur prix = plus bas
+    static constexpr bool descending = std::is_same<Compare, std::greater<Price>>::value;
+
+    using Tree = std::map<Price, OrderQueue, Compare, PoolAllocator<std::pair<const Price, OrderQueue>>>;
+
+    Tree tree;
+    std::unique_ptr<OrderQueue[]> ladder;
+    std::vector<uint64_t> occupied;     // Un bit par tick de la fenêtre
+    std::vector<uint64_t> summary;      // Un bit par mot non nul de `occupied`
+    size_t capacity;
+    size_t ladder_levels;
+    Price anchor;
+
+public:
+    // Les noeuds de l'arbre sont alloués dans l'arène du carnet
+    PriceLevels(size_t ladder_ticks, BookArena& arena);
+
+    bool empty() const { return ladder_levels == 0 && tree.empty(); }
+
+    // Meilleure limite de prix (false si le côté est vide)
+    bool best(Price& price, OrderQueue*& level);
+    // Limite existante à ce prix (nullptr sinon)
+    OrderQueue* find(Price price);
+    // Limite à ce prix, créée si besoin
+    OrderQueue& get_or_create(Price price);
+    // Supprime une limite vide
+    void erase(Price price);
+    // Préchauffe l'arène pour `levels` limites dans l'arbre
+    void reserve(size_t levels);
+    // Précharge la case d'échelle d'un prix (sans effet pour un prix de l'arbre)
+    void prefetch(Price price) const {
+        if (in_ladder(price)) {
+            __builtin_prefetch(&ladder[slot_of(price)]);
+            __builtin_prefetch(&occupied[slot_of(price) >> 6]);
+        }
+    }
+
+private:
+    bool in_ladder(Price price) const {
+        return static_cast<uint64_t>(price) - static_cast<uint64_t>(anchor) < capacity;
+    }
+    size_t slot_of(Price price) const {
+        return static_cast<size_t>(static_cast<uint64_t>(price) - static_cast<uint64_t>(anchor));
+    }
+    void set_bit(size_t slot);
+    void clear_bit(size_t slot);
+    bool ladder_best(size_t& slot) const;
+    void recenter(Price price);
+};
+
+// Implémentation
+
+template <typename Compare>
+PriceLevels<Compare>::PriceLevels(size_t ladder_ticks, BookArena& arena)
+    : tree(Compare(), typename Tree::allocator_type(&arena)), capacity((ladder_ticks + 63) / 64 * 64), ladder_levels(0), anchor(0) {
+    if (capacity > 0) {
+        ladder.reset(new OrderQueue[capacity]);
+        occupied.assign(capacity / 64, 0);
+        summary.assign((occupied.size() + 63) / 64, 0);
+    }
+}
+
+template <typename Compare>
+void PriceLevels<Compare>::set_bit(size_t slot) {
+    occupied[slot >> 6] |= 1ULL << (slot & 63);
+    summary[slot >> 12] |= 1ULL << ((slot >> 6) & 63);
+}
+
+template <typename Compare>
+void PriceLevels<Compare>::clear_bit(size_t slot) {
+    occupied[slot >> 6] &= ~(1ULL << (slot & 63));
+    if (occupied[slot >> 6] == 0) {
+        summary[slot >> 12] &= ~(1ULL << ((slot >> 6) & 63));
+    }
+}
+
+// Meilleure case occupée de l'échelle : plus basse (SELL) ou plus haute (BUY)
+template <typename Compare>
+bool PriceLevels<Compare>::ladder_best(size_t& slot) const {
+    if (ladder_levels == 0) return false;
+    if (descending) {
+        for (size_t s = summary.size(); s-- > 0;) {
+            if (summary[s] == 0) continue;
+            size_t word = s * 64 + (63 - __builtin_clzll(summary[s]));
+            slot = word * 64 + (63 - __builtin_clzll(occupied[word]));
+            return true;
+        }
+    } else {
+        for (size_t s = 0; s < summary.size(); ++s) {
+            if (summary[s] == 0) continue;
+            size_t word = s * 64 + __builtin_ctzll(summary[s]);
+            slot = word * 64 + __builtin_ctzll(occupied[word]);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Compare>
+bool PriceLevels<Compare>::best(Price& price, OrderQueue*& level) {
+    size_t slot;
+    bool has_ladder = ladder_best(slot);
+    bool has_tree = !tree.empty();
+    if (!has_ladder && !has_tree) return false;
+
+    // Les prix de l'arbre sont hors fenêtre : comparaison directe avec le meilleur de l'échelle
+    if (has_ladder && (!has_tree || Compare()(anchor + static_cast<Price>(slot), tree.begin()->first))) {
+        price = anchor + static_cast<Price>(slot);
+        level = &ladder[slot];
+    } else {
+        price = tree.begin()->first;
+        level = &tree.begin()->second;
+    }
+    return true;
+}
+
+template <typename Compare>
+OrderQueue* PriceLevels<Compare>::find(Price price) {
+    if (in_ladder(price)) {
+        size_t slot = slot_of(price);
+        return (occupied[slot >> 6] >> (slot & 63) & 1) ? &ladder[slot] : nullptr;
+    }
+    auto it = tree.find(price);
+    return (it != tree.end()) ? &it->second : nullptr;
+}
+
+template <typename Compare>
+OrderQueue& PriceLevels<Compare>::get_or_create(Price price) {
+    if (capacity > 0 && !in_ladder(price)) {
+        // Recentre l'échelle si elle est vide ou si le meilleur prix en sort
+        size_t slot;
+        if (!ladder_best(slot) || Compare()(price, anchor + static_cast<Price>(slot))) {
+            recenter(price);
+        }
+    }
+
+    if (in_ladder(price)) {
+        size_t slot = slot_of(price);
+        if (!(occupied[slot >> 6] >> (slot & 63) & 1)) {
+            set_bit(slot);
+            ladder_levels++;
+        }
+        return ladder[slot];
+    }
+    return tree[price];
+}
+
+template <typename Compare>
+void PriceLevels<Compare>::erase(Price price) {
+    if (in_ladder(price)) {
+        size_t slot = slot_of(price);
+        if (occupied[slot >> 6] >> (slot & 63) & 1) {
+            clear_bit(slot);
+            ladder_levels--;
+        }
+        return;
+    }
+    tree.erase(price);
+}
+
+template <typename Compare>
+void PriceLevels<Compare>::reserve(size_t levels) {
+    if (!tree.empty()) return;
+    for (size_t i = 0; i < levels; ++i) {
+        tree[static_cast<Price>(i)];
+    }
+    tree.clear();
+}
+
+// Déplace la fenêtre pour la centrer sur `price` ; les limites changent de stockage sans perdre leur file
+template <typename Compare>
+void PriceLevels<Compare>::recenter(Price price) {
+    const Price half = static_cast<Price>(capacity / 2);
+    const Price min_price = std::numeric_limits<Price>::min();
+    const Price max_price = std::numeric_limits<Price>::max();
+
+    // Vide l'échelle dans l'arbre
+    for (size_t word = 0; word < occupied.size() && ladder_levels > 0; ++word) {
+        while (occupied[word] != 0) {
+            size_t slot = word * 64 + __builtin_ctzll(occupied[word]);
+            tree[anchor + static_cast<Price>(slot)].take_from(ladder[slot]);
+            clear_bit(slot);
+            ladder_levels--;
+        }
+    }
+
+    if (price < min_price + half) anchor = min_price;
+    else if (price > max_price - static_cast<Price>(capacity) + half) anchor = max_price - static_cast<Price>(capacity) + 1;
+    else anchor = price - half;
+
+    // Rapatrie dans l'échelle les limites de l'arbre situées dans la nouvelle fenêtre
+    for (auto it = tree.begin(); it != tree.end();) {
+        if (in_ladder(it->first)) {
+            size_t slot = slot_of(it->first);
+            ladder[slot].take_from(it->second);
+            set_bit(slot);
+            ladder_levels++;
+            it = tree.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+#endif // PRICE_LEVELS_H
@@ -0,0 +1,32 @@
+#ifndef RESULT_SINK_H
+#define RESULT_SINK_H
+
+#include "ExecutionReport.h"
+
+// Origine de l'horodatage d'un événement en mode différé (voir OrderBook::set_deferred_timestamps)
+enum class StampKind : uint8_t {
+    LITERAL,    // Timestamp de l'ordre d'entrée, définitif (rejets)
+    NEW,        // Nouvel horodatage d'exécution à calculer depuis le timestamp porté
+    SAME        // Même horodatage que l'événement précédent (contrepartie d'une exécution)
+};
+
+// Destination des événements du moteur, appelée au fil du matching (dans l'ordre d'émission).
+// Sans sink, chaque carnet accumule ses événements dans OrderBook::results.
+class ResultSink {
+public:
+    virtual ~ResultSink() {}
+
+    // Reçoit un événement dès sa production
+    virtual void on_report(const ExecutionReport& report) = 0;
+
+    // Événement à horodatage différé ; par défaut transmis tel quel
+    virtual void on_deferred_report(const ExecutionReport& report, StampKind stamp) {
+        (void)stamp;
+        on_report(report);
+    }
+
+    // Fin du flux : écrit ce qui reste en tampon
+    virtual void flush() {}
+};
+
+#endif // RESULT_SINK_H
@@ -0,0 +1,33 @@
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+#include <cstdint>
+#include <algorithm>
+
+// Séquenceur d'un moteur : horloge des exécutions et numéros d'émission des événements.
+// Chaque moteur possède le sien et le partage avec ses carnets ; il n'est pas synchronisé :
+// un seul thread l'utilise (en mode réparti, le thread qui remet les événements en ordre).
+class Sequencer {
+private:
+    uint64_t last_execution_timestamp;
+    uint64_t emission_sequence;
+
+public:
+    Sequencer() : last_execution_timestamp(0), emission_sequence(0) {}
+
+    // Horodatage d'une exécution : max(base, précédent + 100)
+    uint64_t next_execution_timestamp(uint64_t base_timestamp) {
+        last_execution_timestamp = std::max(base_timestamp, last_execution_timestamp + 100);
+        return last_execution_timestamp;
+    }
+
+    // Numéro d'émission suivant (départage les événements de même timestamp entre carnets)
+    uint64_t next_emission() { return emission_sequence++; }
+
+    void reset() {
+        last_execution_timestamp = 0;
+        emission_sequence = 0;
+    }
+};
+
+#endif // SEQUENCER_H
@@ -0,0 +1,216 @@
+#ifndef SHARDED_ENGINE_H
+#define SHARDED_ENGINE_H
+
+#include "Order.h"
+#include "ExecutionReport.h"
+#include "ResultSink.h"
+#include "OrderBook.h"
+#include "MatchingEngine.h"
+#include "SpscRing.h"
+#include "Sequencer.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+// Moteur réparti sur plusieurs threads : chaque instrument appartient à un shard (instrument % shards),
+// qui possède son propre MatchingEngine et son thread de traitement.
+// Le thread appelant distribue les ordres via des files SPSC et remet les événements des shards
+// dans l'ordre des ordres d'entrée : la sortie est identique à celle du moteur séquentiel.
+// Les doublons d'ID entre instruments de shards différents sont détectés à la distribution.
+class ShardedMatchingEngine {
+private:
+    // Événement d'un shard ; end_of_order marque la fin des événements d'un ordre d'entrée
+    struct ShardEvent {
+        ExecutionReport report;
+        StampKind stamp;
+        bool end_of_order;
+    };
+
+    // Un shard : moteur en horodatage différé, file d'ordres et file d'événements
+    class Shard : public ResultSink {
+    public:
+        MatchingEngine engine;
+        SpscRing<Order> input;
+        SpscRing<ShardEvent> output;
+        std::atomic<bool> running;
+        std::thread worker;
+
+        explicit Shard(size_t ring_capacity)
+            : input(ring_capacity), output(ring_capacity), running(false) {
+            engine.set_deferred_timestamps(true);
+            engine.set_sink(this);
+        }
+
+        void on_report(const ExecutionReport& report) override {
+            on_deferred_report(report, StampKind::LITERAL);
+        }
+
+        void on_deferred_report(const ExecutionReport& report, StampKind stamp) override {
+            publish(ShardEvent{report, stamp, false});
+        }
+
+        // File pleine : attend que le thread appelant la vide, sauf à l'arrêt (l'événement est abandonné)
+        void publish(const ShardEvent& event) {
+            while (!output.try_push(event)) {
+                if (!running.load(std::memory_order_acquire)) return;
+                std::this_thread::yield();
+            }
+        }
+
+        // Boucle du thread : traite les ordres reçus jusqu'à l'arrêt (les ordres encore en file sont abandonnés)
+        void run();
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    // IDs des ordres NEW distribués, tous shards confondus (un doublon est transmis comme rejeté)
+    BookArena index_arena;
+    OrderIndex order_ids;
+    // Shard de chaque ordre en cours, dans l'ordre d'entrée
+    std::deque<size_t> in_flight;
+    ResultSink& sink;
+    // Horloge des exécutions, appliquée dans l'ordre d'entrée par le thread appelant
+    Sequencer sequencer;
+    // Dernier horodatage d'exécution attribué (repris par les événements SAME)
+    uint64_t last_execution_timestamp;
+    bool started;
+
+    void start();
+
+    // Transmet au sink les événements disponibles de l'ordre le plus ancien, puis des suivants.
+    // Non bloquant : s'arrête dès que le shard attendu n'a rien produit. Retourne true si progrès.
+    bool drain();
+    void deliver(ShardEvent& event);
+
+public:
+    ShardedMatchingEngine(size_t shard_count, ResultSink& result_sink, size_t ring_capacity = 4096);
+    ~ShardedMatchingEngine();
+
+    ShardedMatchingEngine(const ShardedMatchingEngine&) = delete;
+    ShardedMatchingEngine& operator=(const ShardedMatchingEngine&) = delete;
+
+    size_t shard_count() const { return shards.size(); }
+
+    // Voir MatchingEngine ; à configurer avant le premier ordre
+    void set_price_ladder(SymbolId instrument, size_t ticks);
+    void set_default_price_ladder(size_t ticks);
+
+    // Distribue un ordre à son shard (les événements prêts sont transmis au passage)
+    void process_order(const Order& order);
+
+    // Distribue `count` ordres dans l'ordre (voir MatchingEngine::process_batch)
+    void process_batch(const Order* orders, size_t count) {
+        for (size_t i = 0; i < count; ++i) process_order(orders[i]);
+    }
+
+    // Attend le traitement de tous les ordres distribués, transmet leurs événements et vide le sink
+    void finish();
+};
+
+// Implémentation
+
+void ShardedMatchingEngine::Shard::run() {
+    Order order;
+    while (running.load(std::memory_order_acquire)) {
+        if (input.try_pop(order)) {
+            engine.process_order(order);
+            publish(ShardEvent{ExecutionReport(), StampKind::LITERAL, true});
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+ShardedMatchingEngine::ShardedMatchingEngine(size_t shard_count, ResultSink& result_sink, size_t ring_capacity)
+    : order_ids(index_arena), sink(result_sink), last_execution_timestamp(0), started(false) {
+    // Les entrées du routeur n'ont pas de noeud : elles passent toutes dans les tombes à chaque compaction
+    order_ids.set_retention(true);
+    if (shard_count == 0) shard_count = 1;
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards.emplace_back(new Shard(ring_capacity));
+    }
+}
+
+// Arrêt : après finish() les files sont vides ; sinon (exception chez l'appelant) le travail restant est abandonné
+ShardedMatchingEngine::~ShardedMatchingEngine() {
+    for (auto& shard : shards) {
+        shard->running.store(false, std::memory_order_release);
+    }
+    for (auto& shard : shards) {
+        if (shard->worker.joinable()) shard->worker.join();
+    }
+}
+
+void ShardedMatchingEngine::start() {
+    // Les threads démarrent au premier ordre : la configuration est alors figée
+    for (auto& shard : shards) {
+        shard->running.store(true, std::memory_order_release);
+        Shard* worker_shard = shard.get();
+        shard->worker = std::thread([worker_shard]() { worker_shard->run(); });
+    }
+    started = true;
+}
+
+void ShardedMatchingEngine::set_price_ladder(SymbolId instrument, size_t ticks) {
+    shards[instrument % shards.size()]->engine.set_price_ladder(instrument, ticks);
+}
+
+void ShardedMatchingEngine::set_default_price_ladder(size_t ticks) {
+    for (auto& shard : shards) {
+        shard->engine.set_default_price_ladder(ticks);
+    }
+}
+
+void ShardedMatchingEngine::process_order(const Order& order) {
+    if (!started) start();
+
+    Order routed = order;
+    if (routed.status != Status::REJECTED && routed.action == Action::NEW) {
+        bool inserted;
+        order_ids.find_or_insert(routed.order_id, inserted);
+        if (!inserted) routed.status = Status::REJECTED;
+    }
+
+    size_t target = order.instrument % shards.size();
+    // File pleine : on avance la remise en ordre pendant que le shard rattrape son retard
+    while (!shards[target]->input.try_push(routed)) {
+        if (!drain()) std::this_thread::yield();
+    }
+    in_flight.push_back(target);
+    drain();
+}
+
+void ShardedMatchingEngine::finish() {
+    while (!in_flight.empty()) {
+        if (!drain()) std::this_thread::yield();
+    }
+    sink.flush();
+}
+
+bool ShardedMatchingEngine::drain() {
+    bool progressed = false;
+    ShardEvent event;
+    while (!in_flight.empty() && shards[in_flight.front()]->output.try_pop(event)) {
+        progressed = true;
+        if (event.end_of_order) {
+            in_flight.pop_front();
+        } else {
+            deliver(event);
+        }
+    }
+    return progressed;
+}
+
+void ShardedMatchingEngine::deliver(ShardEvent& event) {
+    // Horodatage des exécutions dans l'ordre global, comme le ferait le moteur séquentiel
+    if (event.stamp == StampKind::NEW) {
+        last_execution_timestamp = sequencer.next_execution_timestamp(event.report.timestamp);
+        event.report.timestamp = last_execution_timestamp;
+    } else if (event.stamp == StampKind::SAME) {
+        event.report.timestamp = last_execution_timestamp;
+    }
+    sink.on_report(event.report);
+}
+
+#endif // SHARDED_ENGINE_H
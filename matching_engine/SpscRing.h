@@ -0,0 +1,60 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// File circulaire sans verrou : un seul producteur, un seul consommateur.
+// Capacité arrondie à une puissance de 2 ; les index ne font que croître (modulo via masque).
+template <typename T>
+class SpscRing {
+private:
+    std::vector<T> buffer;
+    size_t mask;
+
+    // Côté consommateur : position de lecture et dernière position d'écriture observée
+    alignas(64) std::atomic<size_t> head;
+    size_t cached_tail;
+
+    // Côté producteur : position d'écriture et dernière position de lecture observée
+    alignas(64) std::atomic<size_t> tail;
+    size_t cached_head;
+
+public:
+    explicit SpscRing(size_t capacity) : head(0), cached_tail(0), tail(0), cached_head(0) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        buffer.resize(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producteur : false si la file est pleine
+    bool try_push(const T& item) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cached_head > mask) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (position - cached_head > mask) return false;
+        }
+        buffer[position & mask] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consommateur : false si la file est vide
+    bool try_pop(T& item) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (position == cached_tail) return false;
+        }
+        item = buffer[position & mask];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif // SPSC_RING_H
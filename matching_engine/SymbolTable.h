@@ -0,0 +1,122 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include "Order.h"
+#include "Price.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+// Textes bruts (non canoniques) des champs d'un ordre rejeté, restitués tels quels en sortie
+struct RawFields {
+    std::string side;
+    std::string type;
+    std::string action;
+};
+
+// Table des instruments : interne les noms en identifiants 32 bits et porte leur taille de tick.
+// L'identifiant 0 est réservé à l'instrument vide.
+class SymbolTable {
+private:
+    // Noms stables en mémoire (deque) : les clés de `ids` pointent dessus, la recherche se fait sans copie
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, SymbolId> ids;
+    std::vector<TickSize> tick_sizes;
+    std::vector<bool> has_tick_size;
+    TickSize default_tick;
+    std::vector<RawFields> raw_fields;  // Index 0 réservé (aucun texte brut)
+    // Référence de chaque triplet déjà conservé : une lecture en flux ne grossit qu'avec les textes distincts
+    std::unordered_map<std::string, uint32_t> raw_refs;
+
+public:
+    SymbolTable() {
+        intern("");
+        raw_fields.emplace_back();
+    }
+
+    // Les clés de `ids` pointent sur `names` : pas de copie implicite (voir snapshot_instruments)
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+    SymbolTable(SymbolTable&&) = default;
+    SymbolTable& operator=(SymbolTable&&) = default;
+
+    // Copie des instruments et de leurs tailles de tick, sans les textes bruts.
+    // Les identifiants existants sont conservés ; les nouveaux noms reçoivent les suivants.
+    SymbolTable snapshot_instruments() const;
+
+    // Retourne l'identifiant de l'instrument, créé si besoin
+    SymbolId intern(std::string_view name);
+    // Cherche un instrument sans le créer
+    bool find(std::string_view name, SymbolId& id) const;
+    const std::string& name(SymbolId id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+
+    // Tailles de tick (0.01 par défaut)
+    void set_default_tick_size(const TickSize& tick) { default_tick = tick; }
+    void set_tick_size(std::string_view instrument, const TickSize& tick);
+    const TickSize& tick_size(SymbolId id) const {
+        return has_tick_size[id] ? tick_sizes[id] : default_tick;
+    }
+
+    // Conserve les textes bruts d'un ordre rejeté et retourne leur référence (la même pour des textes identiques)
+    uint32_t store_raw_fields(std::string_view side, std::string_view type, std::string_view action);
+    const RawFields& get_raw_fields(uint32_t ref) const { return raw_fields[ref]; }
+    size_t raw_fields_count() const { return raw_fields.size(); }
+};
+
+// Implémentation
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    SymbolId id = static_cast<SymbolId>(names.size());
+    names.emplace_back(name);
+    tick_sizes.emplace_back();
+    has_tick_size.push_back(false);
+    ids.emplace(std::string_view(names.back()), id);
+    return id;
+}
+
+bool SymbolTable::find(std::string_view name, SymbolId& id) const {
+    auto it = ids.find(name);
+    if (it == ids.end()) return false;
+    id = it->second;
+    return true;
+}
+
+void SymbolTable::set_tick_size(std::string_view instrument, const TickSize& tick) {
+    SymbolId id = intern(instrument);
+    tick_sizes[id] = tick;
+    has_tick_size[id] = true;
+}
+
+SymbolTable SymbolTable::snapshot_instruments() const {
+    SymbolTable copy;
+    for (size_t id = 1; id < names.size(); ++id) {
+        copy.intern(names[id]);
+    }
+    copy.tick_sizes = tick_sizes;
+    copy.has_tick_size = has_tick_size;
+    copy.default_tick = default_tick;
+    return copy;
+}
+
+uint32_t SymbolTable::store_raw_fields(std::string_view side, std::string_view type, std::string_view action) {
+    std::string key;
+    key.reserve(side.size() + type.size() + action.size() + 2);
+    key.append(side).append(1, '\0').append(type).append(1, '\0').append(action);
+    auto it = raw_refs.find(key);
+    if (it != raw_refs.end()) {
+        return it->second;
+    }
+    uint32_t ref = static_cast<uint32_t>(raw_fields.size());
+    raw_fields.push_back(RawFields{std::string(side), std::string(type), std::string(action)});
+    raw_refs.emplace(std::move(key), ref);
+    return ref;
+}
+
+#endif // SYMBOL_TABLE_H
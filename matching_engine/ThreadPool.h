@@ -0,0 +1,143 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+// Pool de threads à vol de tâches : chaque worker a sa propre file et prend ses tâches par la fin ;
+// un worker sans travail en vole au début de la file d'un autre.
+// Adapté à des tâches longues et de durées inégales (un fichier à rejouer par tâche).
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    // Tâches soumises et pas encore terminées, et signalisation worker / wait()
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    size_t queued;
+    size_t unfinished;
+    bool stopping;
+    std::atomic<size_t> next_queue;
+
+    void run(size_t index);
+    // Prend une tâche dans sa file, sinon en vole une ; false si toutes les files sont vides
+    bool take(size_t index, Task& task);
+
+public:
+    // threads = 0 : un worker par coeur disponible
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t thread_count() const { return workers.size(); }
+
+    // Ajoute une tâche (répartition circulaire entre les files des workers) ; elle ne doit pas lever d'exception
+    void submit(Task task);
+
+    // Attend la fin de toutes les tâches soumises
+    void wait();
+};
+
+// Implémentation
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+    : queued(0), unfinished(0), stopping(false), next_queue(0) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (size_t i = 0; i < threads; ++i) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i]() { run(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void WorkStealingPool::submit(Task task) {
+    size_t index = next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        queued++;
+        unfinished++;
+    }
+    work_available.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_done.wait(lock, [this]() { return unfinished == 0; });
+}
+
+bool WorkStealingPool::take(size_t index, Task& task) {
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(size_t index) {
+    while (true) {
+        {
+            // Attend qu'une tâche soit en file (ou l'arrêt)
+            std::unique_lock<std::mutex> lock(state_mutex);
+            work_available.wait(lock, [this]() { return queued > 0 || stopping; });
+            if (queued == 0) return;
+            queued--;
+        }
+
+        // Une tâche est réservée : elle se trouve dans l'une des files
+        Task task;
+        while (!take(index, task)) std::this_thread::yield();
+        task();
+
+        std::lock_guard<std::mutex> lock(state_mutex);
+        if (--unfinished == 0) all_done.notify_all();
+    }
+}
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,123 @@
+#ifndef TOMBSTONE_SET_H
+#define TOMBSTONE_SET_H
+
+#include "MemoryPool.h"
+#include <unordered_map>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Ensemble compact des IDs d'ordres terminés (« tombes ») : seule leur appartenance est conservée, pour
+// rejeter un ID déjà utilisé. Les IDs sont regroupés par blocs de 65536 (16 bits de poids fort) ; un bloc
+// garde la liste triée de ses 16 bits de poids faible tant qu'il compte au plus 4096 IDs (2 octets par ID),
+// puis passe en bitmap de 8 Ko (1 bit par ID possible). Pas de suppression.
+// La mémoire vient de l'arène de l'index : les petites demandes sont servies par ses pools et les autres
+// (listes longues, bitmaps, table des blocs) comptées dans ses allocations sur le tas.
+class TombstoneSet {
+private:
+    static constexpr size_t array_limit = 4096;
+    static constexpr size_t bitmap_words = 65536 / 64;
+
+    struct Container {
+        std::vector<uint16_t, PoolAllocator<uint16_t>> sorted;  // Forme creuse (vide une fois en bitmap)
+        std::vector<uint64_t, PoolAllocator<uint64_t>> bits;    // Forme dense
+
+        explicit Container(BookArena* arena)
+            : sorted(PoolAllocator<uint16_t>(arena)), bits(PoolAllocator<uint64_t>(arena)) {}
+
+        bool contains(uint16_t low) const {
+            if (!bits.empty()) return (bits[low >> 6] >> (low & 63)) & 1;
+            return std::binary_search(sorted.begin(), sorted.end(), low);
+        }
+    };
+
+    using ContainerMap = std::unordered_map<uint64_t, Container, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                                            PoolAllocator<std::pair<const uint64_t, Container>>>;
+
+    BookArena* arena;
+    ContainerMap containers;
+    // Dernier bloc consulté : les IDs arrivent le plus souvent croissants
+    mutable uint64_t last_key;
+    mutable const Container* last;
+    size_t count;
+
+    const Container* find_container(uint64_t key) const;
+
+public:
+    explicit TombstoneSet(BookArena& book_arena)
+        : arena(&book_arena), containers(0, std::hash<uint64_t>(), std::equal_to<uint64_t>(),
+                                         ContainerMap::allocator_type(&book_arena)),
+          last_key(0), last(nullptr), count(0) {}
+
+    // Ajoute un ID (sans effet s'il est déjà présent)
+    void insert(uint64_t order_id);
+    bool contains(uint64_t order_id) const;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Mémoire occupée (blocs et table des blocs), en octets
+    size_t memory_bytes() const;
+};
+
+// Implémentation
+
+const TombstoneSet::Container* TombstoneSet::find_container(uint64_t key) const {
+    if (last != nullptr && last_key == key) return last;
+    auto it = containers.find(key);
+    if (it == containers.end()) return nullptr;
+    last_key = key;
+    last = &it->second;
+    return last;
+}
+
+void TombstoneSet::insert(uint64_t order_id) {
+    uint64_t key = order_id >> 16;
+    uint16_t low = static_cast<uint16_t>(order_id);
+    Container& container = containers.try_emplace(key, arena).first->second;
+    last_key = key;
+    last = &container;
+
+    if (!container.bits.empty()) {
+        uint64_t bit = uint64_t(1) << (low & 63);
+        if (container.bits[low >> 6] & bit) return;
+        container.bits[low >> 6] |= bit;
+        count++;
+        return;
+    }
+
+    // IDs croissants : ajout en fin de liste sans recherche
+    auto& sorted = container.sorted;
+    auto position = (sorted.empty() || sorted.back() < low) ? sorted.end()
+                                                             : std::lower_bound(sorted.begin(), sorted.end(), low);
+    if (position != sorted.end() && *position == low) return;
+    sorted.insert(position, low);
+    count++;
+
+    // Au-delà de 4096 IDs, le bitmap est plus petit que la liste
+    if (sorted.size() > array_limit) {
+        container.bits.assign(bitmap_words, 0);
+        for (uint16_t value : sorted) container.bits[value >> 6] |= uint64_t(1) << (value & 63);
+        decltype(container.sorted)(PoolAllocator<uint16_t>(arena)).swap(sorted);
+    }
+}
+
+bool TombstoneSet::contains(uint64_t order_id) const {
+    if (count == 0) return false;
+    const Container* container = find_container(order_id >> 16);
+    return container != nullptr && container->contains(static_cast<uint16_t>(order_id));
+}
+
+size_t TombstoneSet::memory_bytes() const {
+    // Noeud de la table (clé, bloc, chaînage) et tableau des alvéoles
+    size_t bytes = containers.bucket_count() * sizeof(void*);
+    for (const auto& entry : containers) {
+        bytes += sizeof(entry) + 2 * sizeof(void*);
+        bytes += entry.second.sorted.capacity() * sizeof(uint16_t) + entry.second.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+#endif // TOMBSTONE_SET_H
@@ -3,8 +3,31 @@
 
 #include "Order.h"
 #include <string>
-#include <algorithm>
-#include <cctype>
+#include <string_view>
+#include <cstdint>
+
+// Tables indexées par octet : classe de chaque caractère et majuscule correspondante (ASCII, comme
+// ::toupper dans la locale "C"), pour valider sans copie ni appel de <cctype>
+struct CharTables {
+    enum : uint8_t { DIGIT = 1, SIGN = 2, DOT = 4, SPACE = 8 };
+    uint8_t classes[256];
+    char upper[256];
+};
+
+constexpr CharTables make_char_tables() {
+    CharTables tables{};
+    for (int c = 0; c < 256; ++c) {
+        tables.upper[c] = static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+    }
+    for (int c = '0'; c <= '9'; ++c) tables.classes[c] = CharTables::DIGIT;
+    tables.classes[static_cast<int>('+')] = CharTables::SIGN;
+    tables.classes[static_cast<int>('-')] = CharTables::SIGN;
+    tables.classes[static_cast<int>('.')] = CharTables::DOT;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) tables.classes[static_cast<int>(c)] = CharTables::SPACE;
+    return tables;
+}
+
+constexpr CharTables char_tables = make_char_tables();
 
 // Classe utilitaire de validation des ordres
 class Validator {
@@ -22,73 +45,141 @@ public:
         DUPLICATE_ORDER
     };
     
-    // Valide un ordre
-    static ValidationResult validate_order(const Order& order);
+    // Valide les champs texte d'un ordre lus dans le CSV (avant conversion en enregistrement compact).
+    // Aucune allocation : side, type et action sont comparés sans tenir compte de la casse.
+    static ValidationResult validate_order(std::string_view instrument, std::string_view side,
+                                           std::string_view type, std::string_view action,
+                                           uint64_t quantity, Price price);
+    // Reconnaît side, type et action sans tenir compte de la casse ; l'énumération n'est pas modifiée
+    // si le texte n'est pas reconnu (une chaîne vide n'est pas reconnue)
+    static bool match_side(std::string_view str, Side& side);
+    static bool match_order_type(std::string_view str, OrderType& type);
+    static bool match_action(std::string_view str, Action& action);
     // Convertit une chaîne en majuscules
-    static std::string to_upper(const std::string& str);
+    static std::string to_upper(std::string_view str);
     // Vérifie si une chaîne représente un nombre valide
-    static bool is_valid_number(const std::string& str);
+    static bool is_valid_number(std::string_view str);
     // Vérifie si une chaîne représente un entier valide
-    static bool is_valid_integer(const std::string& str);
+    static bool is_valid_integer(std::string_view str);
     // Vérifie si une chaîne est vide ou contient uniquement des espaces
-    static bool is_empty_or_whitespace(const std::string& str);
+    static bool is_empty_or_whitespace(std::string_view str);
     
 private:
-    // Vérifie si le champ side est valide (BUY / SELL)
-    static bool is_valid_side(const std::string& side);
-    // Vérifie si le champ type est valide (LIMIT / MARKET)
-    static bool is_valid_type(const std::string& type);
-    // Vérifie si le champ action est valide (NEW / MODIFY / CANCEL)
-    static bool is_valid_action(const std::string& action);
+    static uint8_t char_class(char c) { return char_tables.classes[static_cast<unsigned char>(c)]; }
+    // Compare `str` en majuscules à `canonical` (de même longueur)
+    static bool equals_upper(std::string_view str, const char* canonical);
 };
 
 // Fonction principale de validation d'un ordre
-Validator::ValidationResult Validator::validate_order(const Order& order) {
+Validator::ValidationResult Validator::validate_order(std::string_view instrument, std::string_view side,
+                                                     std::string_view type, std::string_view action,
+                                                     uint64_t quantity, Price price) {
     // Vérifie les champs obligatoires non vides
-    if (is_empty_or_whitespace(order.instrument) ||
-        is_empty_or_whitespace(order.side) ||
-        is_empty_or_whitespace(order.type) ||
-        is_empty_or_whitespace(order.action)) {
+    if (is_empty_or_whitespace(instrument) ||
+        is_empty_or_whitespace(side) ||
+        is_empty_or_whitespace(type) ||
+        is_empty_or_whitespace(action)) {
         return ValidationResult::EMPTY_FIELD;
     }
     
     // Validation du side
-    if (!is_valid_side(order.side)) {
+    Side parsed_side;
+    if (!match_side(side, parsed_side)) {
         return ValidationResult::INVALID_SIDE;
     }
     
     // Validation du type
-    if (!is_valid_type(order.type)) {
+    OrderType parsed_type;
+    if (!match_order_type(type, parsed_type)) {
         return ValidationResult::INVALID_TYPE;
     }
     
     // Validation de l'action
-    if (!is_valid_action(order.action)) {
+    Action parsed_action;
+    if (!match_action(action, parsed_action)) {
         return ValidationResult::INVALID_ACTION;
     }
     
     // Validation de la quantité (quantité négative ou débordement)
-    if (order.quantity == 0 || order.quantity > 1000000000000ULL) {
+    if (quantity == 0 || quantity > 1000000000000ULL) {
         return ValidationResult::NEGATIVE_QUANTITY;
     }
     
     // Validation du prix pour les ordres LIMIT
-    if (order.type == "LIMIT" && order.price < 0) {
+    if (parsed_type == OrderType::LIMIT && price < 0) {
         return ValidationResult::NEGATIVE_PRICE;
     }
     
     return ValidationResult::VALID;
 }
 
+bool Validator::equals_upper(std::string_view str, const char* canonical) {
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (char_tables.upper[static_cast<unsigned char>(str[i])] != canonical[i]) return false;
+    }
+    return true;
+}
+
+// Aiguillage sur la longueur (puis la première lettre), une seule comparaison par texte
+bool Validator::match_side(std::string_view str, Side& side) {
+    switch (str.size()) {
+        case 3:
+            if (!equals_upper(str, "BUY")) return false;
+            side = Side::BUY;
+            return true;
+        case 4:
+            if (!equals_upper(str, "SELL")) return false;
+            side = Side::SELL;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Validator::match_order_type(std::string_view str, OrderType& type) {
+    switch (str.size()) {
+        case 5:
+            if (!equals_upper(str, "LIMIT")) return false;
+            type = OrderType::LIMIT;
+            return true;
+        case 6:
+            if (!equals_upper(str, "MARKET")) return false;
+            type = OrderType::MARKET;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Validator::match_action(std::string_view str, Action& action) {
+    switch (str.size()) {
+        case 3:
+            if (!equals_upper(str, "NEW")) return false;
+            action = Action::NEW;
+            return true;
+        case 6:
+            if (char_tables.upper[static_cast<unsigned char>(str[0])] == 'M') {
+                if (!equals_upper(str, "MODIFY")) return false;
+                action = Action::MODIFY;
+            } else {
+                if (!equals_upper(str, "CANCEL")) return false;
+                action = Action::CANCEL;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
 // Conversion en majuscules
-std::string Validator::to_upper(const std::string& str) {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+std::string Validator::to_upper(std::string_view str) {
+    std::string result(str);
+    for (char& c : result) c = char_tables.upper[static_cast<unsigned char>(c)];
     return result;
 }
 
 // Vérifie si la chaîne est un nombre valide
-bool Validator::is_valid_number(const std::string& str) {
+bool Validator::is_valid_number(std::string_view str) {
     if (str.empty()) return false;
     
     bool has_dot = false;
@@ -96,15 +187,16 @@ bool Validator::is_valid_number(const std::string& str) {
     size_t start = 0;
     
     // Signe optionnel en début
-    if (str[0] == '-' || str[0] == '+') {
+    if (char_class(str[0]) == CharTables::SIGN) {
         start = 1;
         if (str.length() == 1) return false;
     }
     
     for (size_t i = start; i < str.length(); ++i) {
-        if (std::isdigit(str[i])) {
+        uint8_t c = char_class(str[i]);
+        if (c == CharTables::DIGIT) {
             has_digit = true;
-        } else if (str[i] == '.' && !has_dot) {
+        } else if (c == CharTables::DOT && !has_dot) {
             has_dot = true;
         } else {
             return false;
@@ -115,17 +207,17 @@ bool Validator::is_valid_number(const std::string& str) {
 }
 
 // Vérifie si la chaîne est un entier valide
-bool Validator::is_valid_integer(const std::string& str) {
+bool Validator::is_valid_integer(std::string_view str) {
     if (str.empty()) return false;
     
     size_t start = 0;
-    if (str[0] == '-' || str[0] == '+') {
+    if (char_class(str[0]) == CharTables::SIGN) {
         start = 1;
         if (str.length() == 1) return false;
     }
     
     for (size_t i = start; i < str.length(); ++i) {
-        if (!std::isdigit(str[i])) {
+        if (char_class(str[i]) != CharTables::DIGIT) {
             return false;
         }
     }
@@ -134,26 +226,11 @@ bool Validator::is_valid_integer(const std::string& str) {
 }
 
 // Vérifie si la chaîne est vide ou ne contient que des espaces
-bool Validator::is_empty_or_whitespace(const std::string& str) {
-    return str.empty() || std::all_of(str.begin(), str.end(), ::isspace);
-}
-
-// Vérifie si le side est valide
-bool Validator::is_valid_side(const std::string& side) {
-    std::string upper_side = to_upper(side);
-    return upper_side == "BUY" || upper_side == "SELL";
-}
-
-// Vérifie si le type est valide
-bool Validator::is_valid_type(const std::string& type) {
-    std::string upper_type = to_upper(type);
-    return upper_type == "LIMIT" || upper_type == "MARKET";
-}
-
-// Vérifie si l'action est valide
-bool Validator::is_valid_action(const std::string& action) {
-    std::string upper_action = to_upper(action);
-    return upper_action == "NEW" || upper_action == "MODIFY" || upper_action == "CANCEL";
+bool Validator::is_empty_or_whitespace(std::string_view str) {
+    for (char c : str) {
+        if (char_class(c) != CharTables::SPACE) return false;
+    }
+    return true;
 }
 
 #endif // VALIDATOR_H
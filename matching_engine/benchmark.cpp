@@ -0,0 +1,664 @@
+#include "Order.h"
+#include "SymbolTable.h"
+#include "OrderBook.h"
+#include "MatchingEngine.h"
+#include "ShardedEngine.h"
+#include "CSVParser.h"
+#include "BinaryEvents.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <deque>
+#include <unordered_map>
+#include <cstring>
+#include <unistd.h>
+
+// Utilitaire pour mesurer le temps d'exécution
+class BenchmarkTimer {
+private:
+    std::chrono::high_resolution_clock::time_point start_time;
+
+public:
+    void start() {
+        start_time = std::chrono::high_resolution_clock::now();
+    }
+
+    // Temps écoulé en nanosecondes
+    double stop() {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end_time - start_time).count();
+    }
+};
+
+SymbolTable symbols;
+
+// Les prix sont exprimés en ticks (tick par défaut : 0.01)
+Order make_order(uint64_t timestamp, uint64_t id, const std::string& instrument,
+                 const std::string& side, const std::string& type, uint64_t quantity,
+                 Price price, const std::string& action) {
+    Order order;
+    order.timestamp = timestamp;
+    order.order_id = id;
+    order.instrument = symbols.intern(instrument);
+    parse_side(side, order.side);
+    parse_order_type(type, order.type);
+    order.quantity = quantity;
+    order.price = price;
+    parse_action(action, order.action);
+    return order;
+}
+
+// Flux cancel/replace : une limite de prix profonde, 90% d'annulations suivies d'un remplacement
+void bench_cancel_replace(size_t depth, size_t operations) {
+    MatchingEngine engine;
+    std::mt19937_64 rng(42);
+    uint64_t timestamp = 1617278400000000000ULL;
+    uint64_t next_id = 1;
+
+    // Construit une file de `depth` ordres au même prix
+    std::vector<uint64_t> resting_ids;
+    resting_ids.reserve(depth);
+    for (size_t i = 0; i < depth; ++i) {
+        engine.process_order(make_order(timestamp += 100, next_id, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+        resting_ids.push_back(next_id++);
+    }
+    engine.clear_results();
+    uint64_t allocations_before = engine.book_allocation_count();
+
+    BenchmarkTimer timer;
+    timer.start();
+    for (size_t i = 0; i < operations; ++i) {
+        size_t slot = rng() % resting_ids.size();
+        if (rng() % 10 != 0) {
+            // Annule un ordre au hasard dans la file puis le remplace en fin de file
+            engine.process_order(make_order(timestamp += 100, resting_ids[slot], "AAPL", "BUY", "LIMIT", 100, 15025, "CANCEL"));
+            engine.process_order(make_order(timestamp += 100, next_id, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+            resting_ids[slot] = next_id++;
+        } else {
+            // Modifie la quantité d'un ordre au repos
+            engine.process_order(make_order(timestamp += 100, resting_ids[slot], "AAPL", "BUY", "LIMIT", 50 + rng() % 100, 15025, "MODIFY"));
+        }
+        if ((i & 1023) == 1023) {
+            engine.clear_results();
+        }
+    }
+    double elapsed = timer.stop();
+
+    uint64_t allocations = engine.book_allocation_count() - allocations_before;
+
+    std::cout << "  depth " << std::setw(6) << depth << ": "
+              << std::fixed << std::setprecision(1) << (elapsed / operations) << " ns/op ("
+              << operations << " ops, " << allocations << " book heap allocations)\n";
+}
+
+// MODIFY sur une limite profonde : baisse de quantité au même prix (ajustée sur place) ou changement
+// de prix aller-retour (retrait, passage au matching et remise en fin de file)
+double bench_modify(size_t depth, size_t operations, bool reduce) {
+    MatchingEngine engine;
+    std::mt19937_64 rng(42);
+    uint64_t timestamp = 1617278400000000000ULL;
+    std::vector<uint64_t> quantities(depth + 1, 1000000);
+    for (uint64_t id = 1; id <= depth; ++id) {
+        engine.process_order(make_order(timestamp += 100, id, "AAPL", "BUY", "LIMIT", quantities[id], 15025, "NEW"));
+    }
+    engine.clear_results();
+
+    Order modify = make_order(timestamp, 0, "AAPL", "BUY", "LIMIT", 0, 15025, "MODIFY");
+    BenchmarkTimer timer;
+    timer.start();
+    for (size_t i = 0; i < operations; ++i) {
+        modify.timestamp += 100;
+        modify.order_id = 1 + rng() % depth;
+        if (reduce) {
+            modify.quantity = --quantities[modify.order_id];
+        } else {
+            modify.quantity = quantities[modify.order_id];
+            modify.price = (i % 2) ? 15025 : 15024;
+        }
+        engine.process_order(modify);
+        if ((i & 1023) == 1023) {
+            engine.clear_results();
+        }
+    }
+    return timer.stop() / operations;
+}
+
+// Flux aléatoire autour du meilleur prix : insertions sur de nombreuses limites et ordres agressifs
+void bench_level_store(const std::string& label, size_t ladder_ticks, size_t operations) {
+    MatchingEngine engine;
+    engine.set_default_price_ladder(ladder_ticks);
+    std::mt19937_64 rng(7);
+    uint64_t timestamp = 1617278400000000000ULL;
+    Price mid = 15000;
+
+    BenchmarkTimer timer;
+    timer.start();
+    for (size_t i = 1; i <= operations; ++i) {
+        bool buy = rng() & 1;
+        // Le prix moyen dérive lentement pour provoquer des recentrages
+        if (i % 5000 == 0) mid += static_cast<Price>(rng() % 41) - 20;
+        Price offset = static_cast<Price>(rng() % 300);
+        bool aggressive = rng() % 8 == 0;
+        Price price = buy ? (aggressive ? mid + offset / 10 : mid - 1 - offset)
+                          : (aggressive ? mid - offset / 10 : mid + 1 + offset);
+        engine.process_order(make_order(timestamp += 100, i, "AAPL", buy ? "BUY" : "SELL", "LIMIT",
+                                        1 + rng() % 200, price, "NEW"));
+        if ((i & 1023) == 1023) {
+            engine.clear_results();
+        }
+    }
+    double elapsed = timer.stop();
+
+    std::cout << "  " << std::setw(22) << std::left << label << std::right << ": "
+              << std::fixed << std::setprecision(1) << (elapsed / operations) << " ns/order ("
+              << operations << " orders)\n";
+}
+
+// Coût par exécution : des ordres agressifs balaient des files d'ordres au repos de petite quantité
+void bench_fill_cost(size_t fills) {
+    MatchingEngine engine;
+    uint64_t timestamp = 1617278400000000000ULL;
+    uint64_t next_id = 1;
+    const size_t sweep = 10;
+
+    BenchmarkTimer timer;
+    double elapsed = 0;
+    size_t done = 0;
+    while (done < fills) {
+        // Remplit 1000 ordres SELL de quantité 1 sur 10 limites (hors mesure)
+        for (size_t i = 0; i < 1000; ++i) {
+            engine.process_order(make_order(timestamp += 100, next_id++, "AAPL", "SELL", "LIMIT", 1,
+                                            15000 + static_cast<Price>(i % 10), "NEW"));
+        }
+        engine.clear_results();
+
+        // Chaque BUY exécute `sweep` ordres au repos
+        timer.start();
+        for (size_t i = 0; i < 1000 / sweep; ++i) {
+            engine.process_order(make_order(timestamp += 100, next_id++, "AAPL", "BUY", "LIMIT", sweep, 15010, "NEW"));
+        }
+        elapsed += timer.stop();
+        done += 1000;
+        engine.clear_results();
+    }
+
+    std::cout << "  engine, full fill path       : " << std::fixed << std::setprecision(1) << (elapsed / done)
+              << " ns/fill (" << done << " fills)\n";
+}
+
+// Tenue des ordres seule, sur la même séquence que bench_fill_cost (1000 ordres au repos de quantité 1,
+// balayés par 100 agressifs de 10) : référence à trois unordered_map, comme le carnet d'origine
+// (order_lookup, existing_order_ids, order_total_executed), comparée à l'OrderIndex du moteur.
+// Seuls l'arrivée des agressifs et les exécutions sont mesurées.
+void bench_fill_bookkeeping(size_t fills) {
+    const size_t sweep = 10;
+    Order order = make_order(1617278400000000000ULL, 0, "AAPL", "SELL", "LIMIT", 1, 15000, "NEW");
+
+    auto run = [&](auto on_arrival, auto on_fill) {
+        BenchmarkTimer timer;
+        double elapsed = 0;
+        uint64_t next_id = 1;
+        for (size_t done = 0; done < fills; done += 1000) {
+            uint64_t first_resting = next_id;
+            for (size_t i = 0; i < 1000; ++i) {
+                order.order_id = next_id++;
+                on_arrival(order);
+            }
+            timer.start();
+            uint64_t resting = first_resting;
+            for (size_t i = 0; i < 1000 / sweep; ++i) {
+                order.order_id = next_id++;
+                on_arrival(order);
+                for (size_t fill = 0; fill < sweep; ++fill) on_fill(order.order_id, resting++);
+            }
+            elapsed += timer.stop();
+        }
+        return elapsed / fills;
+    };
+
+    double maps_ns;
+    {
+        std::unordered_map<uint64_t, Order> order_lookup;
+        std::unordered_map<uint64_t, bool> existing_order_ids;
+        std::unordered_map<uint64_t, uint64_t> order_total_executed;
+        maps_ns = run(
+            [&](const Order& arrival) {
+                existing_order_ids[arrival.order_id] = true;
+                order_total_executed[arrival.order_id] = 0;
+                order_lookup[arrival.order_id] = arrival;
+            },
+            [&](uint64_t aggressor, uint64_t resting) {
+                // Ordre agresseur relu pour son rapport d'exécution
+                order_lookup[aggressor].status = Status::PARTIALLY_EXECUTED;
+                order_total_executed[aggressor] += 1;
+                order_total_executed[resting] += 1;
+                order_lookup.erase(resting);
+            });
+    }
+
+    double index_ns;
+    {
+        BookArena arena;
+        OrderIndex index(arena);
+        index.set_retention(true);
+        OrderSlot* aggressor_slot = nullptr;
+        OrderNode node;
+        index_ns = run(
+            [&](const Order& arrival) {
+                bool inserted;
+                aggressor_slot = index.find_or_insert(arrival.order_id, inserted);
+                aggressor_slot->node = &node;
+            },
+            [&](uint64_t, uint64_t resting) {
+                aggressor_slot->status = Status::PARTIALLY_EXECUTED;
+                aggressor_slot->total_executed += 1;
+                OrderSlot& slot = *index.find(resting);
+                slot.total_executed += 1;
+                slot.status = Status::EXECUTED;
+                slot.node = nullptr;
+            });
+    }
+
+    std::cout << "  bookkeeping, 3 unordered_map : " << std::fixed << std::setprecision(1) << maps_ns << " ns/fill\n"
+              << "  bookkeeping, OrderIndex      : " << index_ns << " ns/fill ("
+              << std::setprecision(0) << (100.0 * (maps_ns - index_ns) / maps_ns) << "% less)\n";
+}
+
+// Sink de benchmark : compte les événements sans les écrire
+class CountingSink : public ResultSink {
+public:
+    uint64_t count = 0;
+    void on_report(const ExecutionReport&) override { count++; }
+};
+
+// Débit d'un flux multi-instruments : moteur séquentiel (threads = 1) ou réparti sur `threads` shards
+void bench_sharded_throughput(const std::vector<Order>& orders, size_t threads) {
+    CountingSink sink;
+    BenchmarkTimer timer;
+    timer.start();
+    if (threads <= 1) {
+        MatchingEngine engine;
+        engine.set_sink(&sink);
+        for (const auto& order : orders) engine.process_order(order);
+    } else {
+        ShardedMatchingEngine engine(threads, sink);
+        for (const auto& order : orders) engine.process_order(order);
+        engine.finish();
+    }
+    double elapsed = timer.stop();
+
+    std::cout << "  threads " << std::setw(2) << threads << ": " << std::fixed << std::setprecision(2)
+              << (orders.size() / elapsed * 1000.0) << " M orders/s (" << sink.count << " events)\n";
+}
+
+// Flux multi-instruments sur de nombreux ordres au repos (index et limites hors du cache) : `resting`
+// ordres NEW, puis `operations` NEW, CANCEL et MODIFY d'ordres pris au hasard
+std::vector<Order> make_batch_flow(size_t resting, size_t operations) {
+    std::vector<Order> flow;
+    flow.reserve(resting + operations);
+    std::mt19937_64 rng(5);
+    std::vector<SymbolId> instruments;
+    for (int i = 0; i < 16; ++i) instruments.push_back(symbols.intern("SYM" + std::to_string(i)));
+
+    Order order = make_order(1617278400000000000ULL, 0, "SYM0", "BUY", "LIMIT", 0, 0, "NEW");
+    uint64_t next_id = 1;
+    for (size_t i = 0; i < resting + operations; ++i) {
+        order.timestamp += 100;
+        uint64_t choice = (i < resting) ? 0 : rng() % 10;
+        if (choice < 5 || next_id == 1) {
+            // Ordre passif, parfois agressif (prix au-delà du milieu)
+            order.action = Action::NEW;
+            order.order_id = next_id++;
+            order.instrument = instruments[rng() % instruments.size()];
+            order.side = (rng() % 2) ? Side::BUY : Side::SELL;
+            Price offset = static_cast<Price>(rng() % 200) - ((i >= resting && rng() % 20 == 0) ? 210 : 0);
+            order.price = (order.side == Side::BUY) ? 14999 - offset : 15001 + offset;
+            order.quantity = 1 + rng() % 100;
+        } else {
+            // CANCEL ou baisse de quantité d'un ordre au hasard (rejeté s'il n'est plus au repos)
+            order.action = (choice < 8) ? Action::CANCEL : Action::MODIFY;
+            order.order_id = 1 + rng() % (next_id - 1);
+            order.instrument = flow[order.order_id - 1].instrument;
+            order.side = flow[order.order_id - 1].side;
+            order.price = flow[order.order_id - 1].price;
+            order.quantity = 1 + rng() % 50;
+        }
+        flow.push_back(order);
+    }
+    return flow;
+}
+
+// Soumission par lots : `batch_size` ordres par appel de process_batch (0 : process_order).
+// Chaque séance part d'un moteur neuf, carnets réservés pour tout le flux (ni agrandissement de l'index
+// ni page neuve dans la mesure) et préchargé des ordres au repos. Les tailles de lot alternent d'une
+// séance à l'autre pour que la dérive de vitesse de la machine ne favorise aucune d'elles ; meilleur
+// temps de `repeats` séances par taille.
+void bench_batch_submission(const std::vector<Order>& flow, size_t resting, const std::vector<size_t>& batch_sizes,
+                            int repeats = 5) {
+    const Order* orders = flow.data() + resting;
+    size_t count = flow.size() - resting;
+    std::vector<double> best(batch_sizes.size(), 0);
+    std::vector<uint64_t> events(batch_sizes.size(), 0);
+    for (int run = 0; run < repeats; ++run) {
+        for (size_t mode = 0; mode < batch_sizes.size(); ++mode) {
+            size_t batch_size = batch_sizes[mode];
+            CountingSink sink;
+            MatchingEngine engine;
+            engine.set_sink(&sink);
+            engine.set_default_price_ladder(1024);
+            for (int i = 0; i < 16; ++i) {
+                engine.reserve_book(symbols.intern("SYM" + std::to_string(i)), flow.size() / 16, 0);
+            }
+            engine.process_batch(flow.data(), resting);
+
+            BenchmarkTimer timer;
+            timer.start();
+            if (batch_size == 0) {
+                for (size_t i = 0; i < count; ++i) engine.process_order(orders[i]);
+            } else {
+                for (size_t start = 0; start < count; start += batch_size) {
+                    engine.process_batch(orders + start, std::min(batch_size, count - start));
+                }
+            }
+            double elapsed = timer.stop();
+            if (run == 0 || elapsed < best[mode]) best[mode] = elapsed;
+            events[mode] = sink.count;
+        }
+    }
+
+    for (size_t mode = 0; mode < batch_sizes.size(); ++mode) {
+        std::string label = batch_sizes[mode] == 0 ? "process_order" : "batch " + std::to_string(batch_sizes[mode]);
+        std::cout << "  " << std::setw(14) << std::left << label << std::right << ": " << std::fixed
+                  << std::setprecision(1) << (best[mode] / count) << " ns/order (" << events[mode] << " events)\n";
+    }
+}
+
+// Fichier d'ordres CSV en mémoire : `lines` ordres NEW valides sur 4 instruments
+std::string make_csv_text(size_t lines) {
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+    const char* instruments[] = {"AAPL", "GOOGL", "MSFT", "TSLA"};
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < lines; ++i) {
+        text += std::to_string(1617278400000000000ULL + i * 100) + "," + std::to_string(i + 1) + "," +
+                instruments[rng() % 4] + "," + ((rng() % 2) ? "BUY" : "SELL") + ",LIMIT," +
+                std::to_string(1 + rng() % 500) + "," + std::to_string(100 + rng() % 100) + "." +
+                std::to_string(10 + rng() % 90) + ",NEW\n";
+    }
+    return text;
+}
+
+// Découpage en lignes et champs seul, par chemin du tokenizer (et recherche caractère par caractère
+// avec std::string_view::find pour comparaison)
+void bench_csv_tokenize(const std::string& text) {
+    auto report = [&text](const char* label, double elapsed, size_t field_count) {
+        std::cout << "  " << std::left << std::setw(8) << label << std::right << ": " << std::fixed
+                  << std::setprecision(0) << (text.size() / elapsed * 1000.0) << " MB/s (" << field_count
+                  << " fields)\n";
+    };
+
+    BenchmarkTimer timer;
+    timer.start();
+    size_t field_count = 0;
+    std::string_view view(text);
+    for (size_t position = 0; position < view.size();) {
+        size_t end = view.find('\n', position);
+        if (end == std::string_view::npos) end = view.size();
+        for (size_t start = position; start < end;) {
+            size_t comma = view.find(',', start);
+            if (comma == std::string_view::npos || comma > end) comma = end;
+            field_count++;
+            start = comma + 1;
+        }
+        position = end + 1;
+    }
+    report("find", timer.stop(), field_count);
+
+    for (CSVTokenizer::ScanPath path : {CSVTokenizer::ScanPath::SCALAR, CSVTokenizer::ScanPath::SSE2,
+                                        CSVTokenizer::ScanPath::AVX2}) {
+        if (!CSVTokenizer::is_supported(path)) continue;
+        timer.start();
+        CSVTokenizer tokenizer(text, path);
+        std::string_view line;
+        LineFields fields;
+        field_count = 0;
+        while (tokenizer.next_line(line, fields)) field_count += fields.count;
+        report(CSVTokenizer::path_name(path), timer.stop(), field_count);
+    }
+}
+
+// Débit du parseur CSV sur un contenu en mémoire (sans lecture disque)
+void bench_csv_parse(const std::string& text, size_t parse_threads) {
+    SymbolTable parse_symbols;
+    uint64_t orders = 0;
+    BenchmarkTimer timer;
+    timer.start();
+    CSVParser::for_each_order_in(text, parse_symbols, [&orders](const Order&) { orders++; }, parse_threads);
+    double elapsed = timer.stop();
+
+    std::cout << "  threads " << std::setw(2) << parse_threads << ": " << std::fixed << std::setprecision(1) << (elapsed / orders) << " ns/line, "
+              << std::setprecision(0) << (text.size() / elapsed * 1000.0) << " MB/s (" << orders << " orders)\n";
+}
+
+// Débit de l'écriture des événements d'exécution : CSV (formatage et écriture par blocs) ou journal binaire
+void bench_output_write(size_t rows) {
+    std::vector<ExecutionReport> reports;
+    std::mt19937 rng(4);
+    for (size_t i = 0; i < rows; ++i) {
+        ExecutionReport report;
+        report.timestamp = 1617278400000000000ULL + i * 100;
+        report.order_id = i + 1;
+        report.counterparty_id = 1 + rng() % rows;
+        report.instrument = symbols.intern((rng() % 2) ? "AAPL" : "MSFT");
+        report.side = (rng() % 2) ? Side::BUY : Side::SELL;
+        report.type = OrderType::LIMIT;
+        report.action = Action::NEW;
+        report.status = (rng() % 2) ? Status::EXECUTED : Status::PARTIALLY_EXECUTED;
+        report.quantity = rng() % 500;
+        report.executed_quantity = 1 + rng() % 500;
+        report.price = 15000 + static_cast<Price>(rng() % 100);
+        report.execution_price = report.price;
+        reports.push_back(report);
+    }
+
+    auto file_size = [](const char* filename) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        return static_cast<double>(file.tellg());
+    };
+
+    BenchmarkTimer timer;
+    timer.start();
+    CSVParser::write_output_file("bench_write.csv", reports, symbols);
+    double csv_elapsed = timer.stop();
+    double csv_bytes = file_size("bench_write.csv");
+    std::remove("bench_write.csv");
+
+    timer.start();
+    {
+        BinaryEventSink sink("bench_write.bin", symbols);
+        for (const auto& report : reports) sink.on_report(report);
+        sink.close();
+    }
+    double binary_elapsed = timer.stop();
+    double binary_bytes = file_size("bench_write.bin");
+    std::remove("bench_write.bin");
+
+    std::cout << "  CSV:    " << std::fixed << std::setprecision(1) << (csv_elapsed / rows) << " ns/row, "
+              << (csv_bytes / rows) << " bytes/row\n";
+    std::cout << "  binary: " << (binary_elapsed / rows) << " ns/row, " << (binary_bytes / rows) << " bytes/row\n";
+}
+
+// Mémoire résidente du processus, en Mo (Linux)
+double resident_mb() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+// Longue séance : ordres passifs annulés 64 ordres plus tard s'ils sont encore au repos, et à chaque
+// cycle un ordre agressif qui balaie un côté du carnet puis est annulé. Tous les ordres finissent
+// terminés : la mémoire de l'index est relevée `reports` fois au cours de la séance.
+// Compte les événements, et les agressifs de la séance exécutés entièrement à leur arrivée
+class SessionSink : public ResultSink {
+public:
+    uint64_t count = 0;
+    uint64_t filled_limit = 0;
+    uint64_t filled_market = 0;
+    void on_report(const ExecutionReport& report) override {
+        count++;
+        if (report.status != Status::EXECUTED || report.order_id % 16 != 0 || report.order_id % 64 == 0) return;
+        if (report.type == OrderType::MARKET) filled_market++;
+        else filled_limit++;
+    }
+};
+
+void bench_session_memory(uint64_t orders, size_t reports) {
+    SessionSink sink;
+    MatchingEngine engine;
+    engine.set_sink(&sink);
+    const OrderIndex& index = engine.get_order_index();
+    std::mt19937 rng(11);
+
+    Order order = make_order(1617278400000000000ULL, 0, "AAPL", "BUY", "LIMIT", 0, 0, "NEW");
+    Order cancel = order;
+    cancel.action = Action::CANCEL;
+    std::deque<uint64_t> resting;
+
+    std::cout << "  " << std::setw(12) << "orders" << std::setw(14) << "table slots" << std::setw(12) << "table KB"
+              << std::setw(12) << "retired" << std::setw(15) << "tombstone KB" << std::setw(10) << "RSS MB" << "\n";
+    BenchmarkTimer timer;
+    timer.start();
+    uint64_t step = std::max<uint64_t>(1, orders / reports);
+    for (uint64_t id = 1; id <= orders; ++id) {
+        order.timestamp += 100;
+        order.order_id = id;
+        if (id % 64 == 0) {
+            // Agressif : balaie tout un côté, puis son reste est annulé
+            order.side = (id % 128 == 0) ? Side::BUY : Side::SELL;
+            order.price = (order.side == Side::BUY) ? 15010 : 14990;
+            order.quantity = 1000000;
+            engine.process_order(order);
+            cancel.timestamp = order.timestamp += 100;
+            cancel.order_id = id;
+            engine.process_order(cancel);
+        } else if (id % 16 == 0) {
+            // Petit agressif LIMIT ou MARKET, le plus souvent exécuté entièrement à son arrivée (jamais annulé)
+            order.side = (rng() % 2) ? Side::BUY : Side::SELL;
+            order.type = (id % 32 == 0) ? OrderType::MARKET : OrderType::LIMIT;
+            order.price = (order.type == OrderType::MARKET) ? 0 : (order.side == Side::BUY) ? 15010 : 14990;
+            order.quantity = 1 + rng() % 20;
+            engine.process_order(order);
+            order.type = OrderType::LIMIT;
+        } else {
+            order.side = (rng() % 2) ? Side::BUY : Side::SELL;
+            order.price = (order.side == Side::BUY) ? 14990 + static_cast<Price>(rng() % 10)
+                                                    : 15001 + static_cast<Price>(rng() % 10);
+            order.quantity = 1 + rng() % 100;
+            engine.process_order(order);
+            resting.push_back(id);
+            if (resting.size() > 64) {
+                // Déjà exécuté par un agressif : l'annulation est rejetée
+                cancel.timestamp = order.timestamp += 100;
+                cancel.order_id = resting.front();
+                engine.process_order(cancel);
+                resting.pop_front();
+            }
+        }
+        if (id % step == 0 || id == orders) {
+            std::cout << "  " << std::setw(12) << id << std::setw(14) << index.capacity() << std::setw(12)
+                      << index.table_bytes() / 1024 << std::setw(12) << index.retired_count() << std::setw(15)
+                      << index.tombstone_bytes() / 1024 << std::setw(10) << std::fixed << std::setprecision(1)
+                      << resident_mb() << "\n";
+        }
+    }
+    double elapsed = timer.stop();
+
+    // Sans rétention, la table garderait une entrée par ID (charge maximale 3/4)
+    uint64_t unbounded_slots = 16;
+    while (unbounded_slots * 3 < orders * 4) unbounded_slots *= 2;
+    std::cout << "  " << std::fixed << std::setprecision(2) << (orders / elapsed * 1000.0) << " M orders/s ("
+              << sink.count << " events, " << sink.filled_limit << " LIMIT and " << sink.filled_market
+              << " MARKET aggressors filled on arrival); without retention the table would need "
+              << unbounded_slots * sizeof(OrderSlot) / (1024 * 1024) << " MB\n";
+}
+
+int main(int argc, char* argv[]) {
+    // --session-orders N : longueur de la séance mesurée par la section « Long session memory »
+    uint64_t session_orders = 10000000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--session-orders") == 0 && i + 1 < argc) {
+            session_orders = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--session-orders N]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Financial Matching Engine - Benchmarks\n";
+    std::cout << std::string(60, '=') << "\n";
+
+    std::cout << "\n=== Cancel/replace on a single deep price level ===\n";
+    for (size_t depth : {10, 100, 1000, 10000}) {
+        bench_cancel_replace(depth, 20000);
+    }
+
+    std::cout << "\n=== MODIFY on a deep price level: in-place reduce vs reprice ===\n";
+    for (size_t depth : {100, 10000}) {
+        double reduce = bench_modify(depth, 200000, true);
+        double reprice = bench_modify(depth, 200000, false);
+        std::cout << "  depth " << std::setw(6) << depth << ": reduce " << std::fixed << std::setprecision(1)
+                  << reduce << " ns/op, reprice " << reprice << " ns/op\n";
+    }
+
+    std::cout << "\n=== Price level store: tree vs dense ladder ===\n";
+    bench_level_store("std::map", 0, 200000);
+    bench_level_store("ladder 1024 ticks", 1024, 200000);
+    bench_level_store("ladder 4096 ticks", 4096, 200000);
+
+    std::cout << "\n=== Per-fill cost ===\n";
+    bench_fill_cost(500000);
+    bench_fill_bookkeeping(500000);
+
+    std::string csv_text = make_csv_text(1000000);
+    std::cout << "\n=== CSV tokenizer throughput (default path: "
+              << CSVTokenizer::path_name(CSVTokenizer::default_path()) << ") ===\n";
+    bench_csv_tokenize(csv_text);
+
+    std::cout << "\n=== CSV parse throughput ===\n";
+    for (size_t threads : {1, 2, 4}) {
+        bench_csv_parse(csv_text, threads);
+    }
+
+    std::cout << "\n=== Output write throughput (1000000 rows) ===\n";
+    bench_output_write(1000000);
+
+    std::cout << "\n=== Sharded engine throughput (16 instruments, "
+              << std::thread::hardware_concurrency() << " hardware threads) ===\n";
+    std::vector<Order> flow;
+    std::mt19937 rng(7);
+    for (uint64_t i = 0; i < 400000; ++i) {
+        std::string instrument = "SYM" + std::to_string(rng() % 16);
+        flow.push_back(make_order(1617278400000000000ULL + i * 100, i + 1, instrument,
+                                  (rng() % 2) ? "BUY" : "SELL", "LIMIT", 1 + rng() % 100,
+                                  15000 + static_cast<Price>(rng() % 40), "NEW"));
+    }
+    for (size_t threads : {1, 2, 4}) {
+        bench_sharded_throughput(flow, threads);
+    }
+
+    std::cout << "\n=== Batch submission (16 instruments, 1000000 resting orders, dense ladders) ===\n";
+    {
+        std::vector<Order> batch_flow = make_batch_flow(1000000, 2000000);
+        bench_batch_submission(batch_flow, 1000000, {0, 1, 16, 256});
+    }
+
+    std::cout << "\n=== Long session memory (" << session_orders << " orders, terminal orders retired) ===\n";
+    bench_session_memory(session_orders, 10);
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "CSVParser.h"
+#include "BinaryEvents.h"
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+
+// Conversion d'un journal d'événements binaire (matching_engine --binary-output) en CSV de sortie,
+// identique à celui que matching_engine aurait écrit directement.
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input_bin> <output_csv>" << std::endl;
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        SymbolTable symbols;
+        CSVSink sink(argv[2], symbols);
+        if (!sink.is_open()) {
+            std::cerr << "Error: Could not open output file: " << argv[2] << std::endl;
+            return 1;
+        }
+
+        if (!BinaryEventFile::for_each_report(argv[1], symbols,
+                                              [&sink](const ExecutionReport& report) { sink.on_report(report); })) {
+            return 1;
+        }
+        sink.flush();
+
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Wrote " << sink.row_count() << " result records to " << argv[2] << " in "
+                  << std::fixed << std::setprecision(2) << elapsed << " ms" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
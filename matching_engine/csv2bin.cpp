@@ -0,0 +1,89 @@
+#include "Order.h"
+#include "Validator.h"
+#include "CSVParser.h"
+#include "BinaryOrders.h"
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <cstdio>
+
+// Conversion d'un fichier d'ordres CSV au format binaire (voir BinaryOrders.h) : le parsing et la
+// validation (rejets, doublons, avertissements) sont ceux de matching_engine, faits une fois pour toutes.
+// Le fichier binaire se rejoue ensuite avec matching_engine ou replay, sans parsing.
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " <input_csv | -> <output_bin> [options]\n"
+              << "Options:\n"
+              << "  --tick-size INSTRUMENT=SIZE   Tick size for an instrument (default 0.01), stored in the file\n"
+              << "  --parse-threads N             Parse the input on N threads"
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> positional;
+    SymbolTable symbols;
+    size_t parse_threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tick-size" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            TickSize tick;
+            if (eq == std::string::npos || eq == 0 || !TickSize::parse(spec.substr(eq + 1), tick)) {
+                std::cerr << "Error: Invalid tick size specification: " << spec << std::endl;
+                return 1;
+            }
+            symbols.set_tick_size(spec.substr(0, eq), tick);
+        } else if (arg == "--parse-threads" && i + 1 < argc) {
+            std::string count = argv[++i];
+            if (!Validator::is_valid_integer(count) || count[0] == '-' || std::stoull(count) == 0) {
+                std::cerr << "Error: Invalid thread count: " << count << std::endl;
+                return 1;
+            }
+            parse_threads = std::stoull(count);
+        } else if (arg.rfind("--", 0) == 0) {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        BinaryOrderWriter writer;
+        if (!writer.open(positional[1])) {
+            std::cerr << "Error: Could not open output file: " << positional[1] << std::endl;
+            return 1;
+        }
+
+        uint64_t rejected = 0;
+        bool opened = CSVParser::for_each_order(positional[0], symbols, [&](const Order& order) {
+            if (order.status == Status::REJECTED) rejected++;
+            writer.write(order);
+        }, parse_threads);
+        if (!opened) {
+            std::remove(positional[1].c_str());
+            return 1;
+        }
+        writer.close(symbols);
+
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Converted " << writer.count() << " orders (" << rejected << " rejected, "
+                  << (symbols.size() - 1) << " instruments) to " << positional[1] << " in "
+                  << std::fixed << std::setprecision(2) << elapsed << " ms" << std::endl;
+    } catch (const std::exception& e) {
+        // Pas de fichier binaire incomplet
+        std::remove(positional[1].c_str());
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,8 +1,13 @@
 #include "Order.h"
 #include "Validator.h"
 #include "CSVParser.h"
+#include "BinaryOrders.h"
+#include "BinaryEvents.h"
 #include "OrderBook.h"
 #include "MatchingEngine.h"
+#include "ShardedEngine.h"
+#include "Pipeline.h"
+#include "ResultSink.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -24,49 +29,193 @@ public:
     }
 };
 
+// Compte les événements par statut avant de les transmettre au sink suivant
+class StatisticsSink : public ResultSink {
+private:
+    ResultSink& next;
+    uint64_t counts[static_cast<int>(Status::REJECTED) + 1];
+
+public:
+    explicit StatisticsSink(ResultSink& next_sink) : next(next_sink), counts() {}
+
+    void on_report(const ExecutionReport& report) override {
+        counts[static_cast<int>(report.status)]++;
+        next.on_report(report);
+    }
+
+    void flush() override { next.flush(); }
+
+    uint64_t count(Status status) const { return counts[static_cast<int>(status)]; }
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for (uint64_t value : counts) sum += value;
+        return sum;
+    }
+};
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " <input_file | -> <output_file> [options]\n"
+              << "Options:\n"
+              << "  --tick-size INSTRUMENT=SIZE   Tick size for an instrument (default 0.01)\n"
+              << "  --ladder INSTRUMENT[=TICKS]   Dense price ladder for an instrument ('*' = all, default 1024 ticks)\n"
+              << "  --threads N                   Match instruments on N threads (output unchanged)\n"
+              << "  --parse-threads N             Parse the input on N threads (output unchanged)\n"
+              << "  --pipeline                    Read, match and write on separate threads (output unchanged)\n"
+              << "  --binary-output               Write a binary event log instead of CSV (see bin2csv)\n"
+              << "  --avx2-scan                   Scan CSV delimiters with AVX2 instead of SSE2 (if supported)"
+              << std::endl;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::cerr << "Usage: " << argv[0] << " <input_file> <output_file>" << std::endl;
+    std::vector<std::string> positional;
+    SymbolTable symbols;
+    std::vector<std::pair<std::string, size_t>> ladders;
+    size_t threads = 1;
+    size_t parse_threads = 1;
+    bool pipelined = false;
+    bool binary_output = false;
+
+    // Lecture des arguments (fichiers + options)
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tick-size" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            TickSize tick;
+            if (eq == std::string::npos || eq == 0 || !TickSize::parse(spec.substr(eq + 1), tick)) {
+                std::cerr << "Error: Invalid tick size specification: " << spec << std::endl;
+                return 1;
+            }
+            symbols.set_tick_size(spec.substr(0, eq), tick);
+        } else if (arg == "--ladder" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            size_t ladder_size = 1024;
+            if (eq != std::string::npos) {
+                std::string size_str = spec.substr(eq + 1);
+                if (!Validator::is_valid_integer(size_str) || size_str[0] == '-') {
+                    std::cerr << "Error: Invalid ladder specification: " << spec << std::endl;
+                    return 1;
+                }
+                ladder_size = std::stoull(size_str);
+            }
+            ladders.emplace_back(spec.substr(0, eq), ladder_size);
+        } else if ((arg == "--threads" || arg == "--parse-threads") && i + 1 < argc) {
+            std::string count = argv[++i];
+            if (!Validator::is_valid_integer(count) || count[0] == '-' || std::stoull(count) == 0) {
+                std::cerr << "Error: Invalid thread count: " << count << std::endl;
+                return 1;
+            }
+            (arg == "--threads" ? threads : parse_threads) = std::stoull(count);
+        } else if (arg == "--pipeline") {
+            pipelined = true;
+        } else if (arg == "--binary-output") {
+            binary_output = true;
+        } else if (arg == "--avx2-scan") {
+            CSVTokenizer::set_prefer_avx2(true);
+        } else if (arg.rfind("--", 0) == 0) {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 2) {
+        print_usage(argv[0]);
         return 1;
     }
     
-    std::string input_file = argv[1];
-    std::string output_file = argv[2];
+    std::string input_file = positional[0];
+    std::string output_file = positional[1];
     
     try {
         PerformanceTimer timer;
         timer.start();
         
-        // Lecture du fichier d'entrée
+        // En pipeline, l'écriture formate avec sa propre copie de la table des instruments
+        std::unique_ptr<MatchingPipeline> pipeline;
+        if (pipelined) pipeline.reset(new MatchingPipeline(symbols));
+
+        // Sortie en flux : chaque événement est écrit dès sa production (CSV ou journal binaire)
+        const SymbolTable& output_symbols = pipeline ? pipeline->output_symbols() : symbols;
+        std::unique_ptr<CSVSink> csv_sink;
+        std::unique_ptr<BinaryEventSink> binary_sink;
+        bool output_open;
+        if (binary_output) {
+            binary_sink.reset(new BinaryEventSink(output_file, output_symbols));
+            output_open = binary_sink->is_open();
+        } else {
+            csv_sink.reset(new CSVSink(output_file, output_symbols));
+            output_open = csv_sink->is_open();
+        }
+        if (!output_open) {
+            std::cerr << "Error: Could not open output file: " << output_file << std::endl;
+            return 1;
+        }
+        StatisticsSink stats(binary_sink ? static_cast<ResultSink&>(*binary_sink) : *csv_sink);
+        ResultSink& engine_sink = pipeline ? pipeline->engine_sink() : static_cast<ResultSink&>(stats);
+
+        // Un seul thread : moteur séquentiel ; sinon un shard (moteur + thread) par groupe d'instruments
+        MatchingEngine engine;
+        std::unique_ptr<ShardedMatchingEngine> sharded;
+        if (threads > 1) {
+            sharded.reset(new ShardedMatchingEngine(threads, engine_sink));
+        } else {
+            engine.set_sink(&engine_sink);
+        }
+        for (const auto& [instrument, ladder_size] : ladders) {
+            if (instrument == "*") {
+                if (sharded) sharded->set_default_price_ladder(ladder_size);
+                else engine.set_default_price_ladder(ladder_size);
+            } else {
+                SymbolId id = symbols.intern(instrument);
+                if (sharded) sharded->set_price_ladder(id, ladder_size);
+                else engine.set_price_ladder(id, ladder_size);
+            }
+        }
+
+        // Lecture du fichier d'entrée et traitement des ordres au fil de l'eau ; les lignes de sortie
+        // suivent l'ordre de traitement, sans tri global par timestamp (voir README)
         std::cout << "Reading input file: " << input_file << std::endl;
-        std::vector<Order> orders = CSVParser::parse_input_file(input_file);
-        std::cout << "Parsed " << orders.size() << " orders" << std::endl;
-        
-        // Comptage des ordres rejetés
+        std::cout << "Processing orders..." << std::endl;
+        size_t order_count = 0;
         int rejected_count = 0;
-        for (const auto& order : orders) {
-            if (order.status == "REJECTED") {
-                rejected_count++;
-            }
+        if (pipeline) {
+            pipeline->run(input_file, parse_threads, stats,
+                [&](const Order* orders, size_t count) {
+                    if (sharded) sharded->process_batch(orders, count);
+                    else engine.process_batch(orders, count);
+                },
+                [&]() {
+                    if (sharded) sharded->finish();
+                });
+            order_count = pipeline->order_count();
+            rejected_count = static_cast<int>(pipeline->rejected_count());
+        } else {
+            BinaryOrderFile::for_each_order(input_file, symbols, [&](const Order& order) {
+                order_count++;
+                if (order.status == Status::REJECTED) {
+                    rejected_count++;
+                }
+                if (sharded) sharded->process_order(order);
+                else engine.process_order(order);
+            }, parse_threads);
+            if (sharded) sharded->finish();
+            else stats.flush();
         }
+        if (binary_sink) binary_sink->close();
+        std::cout << "Parsed " << order_count << " orders" << std::endl;
         
+        // Rejets de lecture seulement : les doublons d'ID et les autres rejets du moteur sont comptés
+        // dans les statistiques d'exécution (Rejected)
         if (rejected_count > 0) {
-            std::cout << "Warning: " << rejected_count << " orders were rejected due to validation errors" << std::endl;
+            std::cout << "Warning: " << rejected_count << " orders failed parsing or validation "
+                      << "(duplicate IDs are rejected by the engine, see Rejected below)" << std::endl;
         }
         
-        // Traitement des ordres par le moteur de matching
-        std::cout << "Processing orders..." << std::endl;
-        MatchingEngine engine;
-        
-        for (const auto& order : orders) {
-            engine.process_order(order);
-        }
-        
-        // Récupération des résultats et écriture du fichier de sortie
-        std::vector<Order> results = engine.get_all_results();
-        std::cout << "Generated " << results.size() << " result records" << std::endl;
-        
-        CSVParser::write_output_file(output_file, results);
+        std::cout << "Generated " << stats.total() << " result records" << std::endl;
         std::cout << "Output written to: " << output_file << std::endl;
         
         // Affichage du temps total de traitement
@@ -74,20 +223,29 @@ int main(int argc, char* argv[]) {
         std::cout << "Total processing time: " << std::fixed << std::setprecision(2) 
                   << elapsed << " ms" << std::endl;
         
-        if (orders.size() > 0) {
+        if (order_count > 0) {
             std::cout << "Average time per order: " << std::fixed << std::setprecision(3)
-                      << (elapsed / orders.size()) << " ms" << std::endl;
+                      << (elapsed / order_count) << " ms" << std::endl;
         }
         
-        // Statistiques d'exécution
-        int executed = 0, partially_executed = 0, pending = 0, canceled = 0, rejected = 0;
-        for (const auto& result : results) {
-            if (result.status == "EXECUTED") executed++;
-            else if (result.status == "PARTIALLY_EXECUTED") partially_executed++;
-            else if (result.status == "PENDING") pending++;
-            else if (result.status == "CANCELED") canceled++;
-            else if (result.status == "REJECTED") rejected++;
+        if (pipeline) {
+            std::cout << "Pipeline stages (busy / idle):" << std::endl;
+            const std::pair<const char*, const StageTimes*> stages[] = {
+                {"Reader", &pipeline->reader_times()},
+                {"Matcher", &pipeline->matcher_times()},
+                {"Writer", &pipeline->writer_times()}};
+            for (const auto& [stage_name, times] : stages) {
+                std::cout << "  " << stage_name << ": " << std::fixed << std::setprecision(2)
+                          << times->busy_ms << " ms / " << times->idle_ms << " ms" << std::endl;
+            }
         }
+
+        // Statistiques d'exécution
+        uint64_t executed = stats.count(Status::EXECUTED);
+        uint64_t partially_executed = stats.count(Status::PARTIALLY_EXECUTED);
+        uint64_t pending = stats.count(Status::PENDING);
+        uint64_t canceled = stats.count(Status::CANCELED);
+        uint64_t rejected = stats.count(Status::REJECTED);
         
         std::cout << "\nExecution Statistics:" << std::endl;
         std::cout << "  Executed: " << executed << std::endl;
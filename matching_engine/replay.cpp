@@ -0,0 +1,201 @@
+#include "Order.h"
+#include "Validator.h"
+#include "CSVParser.h"
+#include "BinaryOrders.h"
+#include "MatchingEngine.h"
+#include "ResultSink.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+
+// Rejeu en lot : chaque fichier d'entrée est traité par un moteur indépendant (symboles, carnets,
+// séquenceur), les fichiers étant répartis sur un pool de threads. La sortie de `jour.csv` est écrite
+// à côté, dans `jour_output.csv`, identique à celle de `matching_engine jour.csv jour_output.csv`.
+
+// Réglages communs à tous les fichiers (mêmes options que matching_engine)
+struct ReplaySettings {
+    std::vector<std::pair<std::string, TickSize>> tick_sizes;
+    std::vector<std::pair<std::string, size_t>> ladders;
+};
+
+// Bilan du rejeu d'un fichier
+struct ReplayResult {
+    std::string input_file;
+    std::string output_file;
+    bool ok = false;
+    uint64_t orders = 0;
+    uint64_t events = 0;
+    double elapsed_ms = 0;
+};
+
+double elapsed_ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string output_path_for(const std::string& input_file) {
+    std::filesystem::path path(input_file);
+    return (path.parent_path() / (path.stem().string() + "_output.csv")).string();
+}
+
+void replay_file(const ReplaySettings& settings, ReplayResult& result) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        SymbolTable symbols;
+        for (const auto& [instrument, tick] : settings.tick_sizes) {
+            symbols.set_tick_size(instrument, tick);
+        }
+
+        CSVSink sink(result.output_file, symbols);
+        if (!sink.is_open()) {
+            std::cerr << "Error: Could not open output file: " << result.output_file << std::endl;
+            return;
+        }
+
+        MatchingEngine engine;
+        engine.set_sink(&sink);
+        for (const auto& [instrument, ladder_size] : settings.ladders) {
+            if (instrument == "*") engine.set_default_price_ladder(ladder_size);
+            else engine.set_price_ladder(symbols.intern(instrument), ladder_size);
+        }
+
+        result.ok = BinaryOrderFile::for_each_order(result.input_file, symbols, [&](const Order& order) {
+            result.orders++;
+            engine.process_order(order);
+        });
+        sink.flush();
+        result.events = sink.row_count();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << result.input_file << ": " << e.what() << std::endl;
+        result.ok = false;
+    }
+    result.elapsed_ms = elapsed_ms_since(start);
+}
+
+// Fichiers d'ordres d'un répertoire (CSV ou binaires, hors sorties d'un rejeu précédent), triés par nom
+std::vector<std::string> list_input_files(const std::string& directory) {
+    std::vector<std::string> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        std::string name = entry.path().filename().string();
+        bool is_output = name.size() >= 11 && name.compare(name.size() - 11, 11, "_output.csv") == 0;
+        bool is_input = entry.path().extension() == ".csv" || entry.path().extension() == ".bin";
+        if (entry.is_regular_file() && is_input && !is_output) {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <input_file|directory>...\n"
+              << "Options:\n"
+              << "  --threads N                   Worker threads (default: hardware concurrency)\n"
+              << "  --tick-size INSTRUMENT=SIZE   Tick size for an instrument (default 0.01)\n"
+              << "  --ladder INSTRUMENT[=TICKS]   Dense price ladder for an instrument ('*' = all, default 1024 ticks)"
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    ReplaySettings settings;
+    std::vector<std::string> inputs;
+    size_t threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            std::string count = argv[++i];
+            if (!Validator::is_valid_integer(count) || count[0] == '-' || std::stoull(count) == 0) {
+                std::cerr << "Error: Invalid thread count: " << count << std::endl;
+                return 1;
+            }
+            threads = std::stoull(count);
+        } else if (arg == "--tick-size" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            TickSize tick;
+            if (eq == std::string::npos || eq == 0 || !TickSize::parse(spec.substr(eq + 1), tick)) {
+                std::cerr << "Error: Invalid tick size specification: " << spec << std::endl;
+                return 1;
+            }
+            settings.tick_sizes.emplace_back(spec.substr(0, eq), tick);
+        } else if (arg == "--ladder" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            size_t ladder_size = 1024;
+            if (eq != std::string::npos) {
+                std::string size_str = spec.substr(eq + 1);
+                if (!Validator::is_valid_integer(size_str) || size_str[0] == '-') {
+                    std::cerr << "Error: Invalid ladder specification: " << spec << std::endl;
+                    return 1;
+                }
+                ladder_size = std::stoull(size_str);
+            }
+            settings.ladders.emplace_back(spec.substr(0, eq), ladder_size);
+        } else if (arg.rfind("--", 0) == 0) {
+            print_usage(argv[0]);
+            return 1;
+        } else if (std::filesystem::is_directory(arg)) {
+            std::vector<std::string> files = list_input_files(arg);
+            inputs.insert(inputs.end(), files.begin(), files.end());
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<ReplayResult> results(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        results[i].input_file = inputs[i];
+        results[i].output_file = output_path_for(inputs[i]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t thread_count;
+    {
+        WorkStealingPool pool(threads);
+        thread_count = pool.thread_count();
+        std::cout << "Replaying " << inputs.size() << " files on " << thread_count << " threads..." << std::endl;
+        for (auto& result : results) {
+            pool.submit([&settings, &result]() { replay_file(settings, result); });
+        }
+        pool.wait();
+    }
+    double elapsed = elapsed_ms_since(start);
+
+    // Bilan par fichier puis agrégé
+    uint64_t total_orders = 0;
+    uint64_t total_events = 0;
+    size_t failed = 0;
+    std::cout << "\nPer-file results:" << std::endl;
+    for (const auto& result : results) {
+        if (!result.ok) {
+            failed++;
+            std::cout << "  " << result.input_file << ": FAILED" << std::endl;
+            continue;
+        }
+        total_orders += result.orders;
+        total_events += result.events;
+        std::cout << "  " << result.input_file << ": " << result.orders << " orders, " << result.events
+                  << " events, " << std::fixed << std::setprecision(2) << result.elapsed_ms << " ms -> "
+                  << result.output_file << std::endl;
+    }
+
+    std::cout << "\nReplay Statistics:" << std::endl;
+    std::cout << "  Files: " << (results.size() - failed) << " replayed, " << failed << " failed" << std::endl;
+    std::cout << "  Orders: " << total_orders << std::endl;
+    std::cout << "  Events: " << total_events << std::endl;
+    std::cout << "  Wall time: " << std::fixed << std::setprecision(2) << elapsed << " ms" << std::endl;
+    if (elapsed > 0) {
+        std::cout << "  Throughput: " << std::fixed << std::setprecision(0) << (total_orders / elapsed * 1000.0)
+                  << " orders/s, " << (total_events / elapsed * 1000.0) << " events/s" << std::endl;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -3,12 +3,22 @@
 #include "CSVParser.h"
 #include "OrderBook.h"
 #include "MatchingEngine.h"
+#include "ShardedEngine.h"
+#include "ThreadPool.h"
+#include "Pipeline.h"
+#include "BinaryOrders.h"
+#include "BinaryEvents.h"
 #include <iostream>
 #include <vector>
 #include <fstream>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdio>
 
 class TestFramework {
     int tests_run = 0, tests_passed = 0;
@@ -70,18 +80,22 @@ std::vector<std::string> parse_expected_output() {
     return expected_lines;
 }
 
+// Instruments partagés par les tests
+SymbolTable test_symbols;
+
+// Les prix sont exprimés en ticks (tick par défaut : 0.01)
 Order create_order(uint64_t timestamp, uint64_t id, const std::string& instrument, 
                    const std::string& side, const std::string& type, uint64_t quantity, 
-                   double price, const std::string& action) {
+                   Price price, const std::string& action) {
     Order order;
     order.timestamp = timestamp;
     order.order_id = id;
-    order.instrument = instrument;
-    order.side = side;
-    order.type = type;
+    order.instrument = test_symbols.intern(instrument);
+    parse_side(side, order.side);
+    parse_order_type(type, order.type);
     order.quantity = quantity;
     order.price = price;
-    order.action = action;
+    parse_action(action, order.action);
     return order;
 }
 
@@ -91,7 +105,7 @@ void test_exact_expected_output(TestFramework& tf) {
     create_test_input_csv();
     
     // Analyse du fichier d'entrée
-    std::vector<Order> orders = CSVParser::parse_input_file("input.csv");
+    std::vector<Order> orders = CSVParser::parse_input_file("input.csv", test_symbols);
     
     // Traitement avec le Matching Engine
     MatchingEngine engine;
@@ -100,8 +114,8 @@ void test_exact_expected_output(TestFramework& tf) {
     }
     
     // Obtention des résultats et écriture de la sortie
-    std::vector<Order> results = engine.get_all_results();
-    CSVParser::write_output_file("output.csv", results);
+    std::vector<ExecutionReport> results = engine.get_all_results();
+    CSVParser::write_output_file("output.csv", results, test_symbols);
     
     // Lecture du fichier de sortie généré
     std::ifstream output_file("output.csv");
@@ -148,22 +162,32 @@ void test_validation_comprehensive(TestFramework& tf) {
     std::cout << "\n=== Testing Comprehensive Validation ===\n";
     
     // Test d'un ordre valide
-    Order valid = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
     tf.assert_equal("Valid order validation", (int)Validator::ValidationResult::VALID, 
-                    (int)Validator::validate_order(valid));
+                    (int)Validator::validate_order("AAPL", "BUY", "LIMIT", "NEW", 100, 15025));
     
     // Test d'un side invalide
-    Order invalid_side = valid;
-    invalid_side.side = "INVALID";
     tf.assert_equal("Invalid side validation", (int)Validator::ValidationResult::INVALID_SIDE,
-                    (int)Validator::validate_order(invalid_side));
+                    (int)Validator::validate_order("AAPL", "INVALID", "LIMIT", "NEW", 100, 15025));
     
     // Test d'un champ vide
-    Order empty_field = valid;
-    empty_field.instrument = "";
     tf.assert_equal("Empty field validation", (int)Validator::ValidationResult::EMPTY_FIELD,
-                    (int)Validator::validate_order(empty_field));
-    
+                    (int)Validator::validate_order("", "BUY", "LIMIT", "NEW", 100, 15025));
+    
+    // Casse et espaces : mêmes codes que sur les textes en majuscules
+    tf.assert_equal("Lower case order validation", (int)Validator::ValidationResult::VALID,
+                    (int)Validator::validate_order("AAPL", "sell", "Market", "cancel", 100, 0));
+    tf.assert_equal("Negative price on lower case limit", (int)Validator::ValidationResult::NEGATIVE_PRICE,
+                    (int)Validator::validate_order("AAPL", "Buy", "limit", "Modify", 100, -1));
+    tf.assert_equal("Invalid action validation", (int)Validator::ValidationResult::INVALID_ACTION,
+                    (int)Validator::validate_order("AAPL", "BUY", "LIMIT", "MODIFz", 100, 15025));
+    tf.assert_equal("Whitespace field validation", (int)Validator::ValidationResult::EMPTY_FIELD,
+                    (int)Validator::validate_order("AAPL", "BUY", " \t\v", "NEW", 100, 15025));
+    Action action = Action::NONE;
+    tf.assert_true("Action matched without case",
+                   Validator::match_action("cAnCeL", action) && action == Action::CANCEL);
+    tf.assert_true("Unknown action leaves enum unchanged",
+                   !Validator::match_action("CANCE", action) && action == Action::CANCEL);
+
     // Test des fonctions utilitaires
     tf.assert_equal("Upper case conversion", std::string("BUY"), Validator::to_upper("buy"));
     tf.assert_true("Valid integer check", Validator::is_valid_integer("123"));
@@ -172,6 +196,87 @@ void test_validation_comprehensive(TestFramework& tf) {
     tf.assert_true("Invalid number check", !Validator::is_valid_number("12.3.4"));
 }
 
+void test_tick_price_conversion(TestFramework& tf) {
+    std::cout << "\n=== Testing Tick Price Conversion ===\n";
+
+    TickSize cents;
+    Price ticks = 0;
+    tf.assert_true("Parse 150.25", cents.to_ticks("150.25", ticks));
+    tf.assert_equal("150.25 in cents", (Price)15025, ticks);
+    cents.to_ticks("150.3", ticks);
+    tf.assert_equal("150.3 in cents", (Price)15030, ticks);
+    cents.to_ticks("150.30", ticks);
+    tf.assert_equal("150.30 same level as 150.3", (Price)15030, ticks);
+    cents.to_ticks("-1.005", ticks);
+    tf.assert_equal("Rounded to nearest tick", (Price)-101, ticks);
+    tf.assert_true("Overflow rejected", !cents.to_ticks("99999999999999999999", ticks));
+
+    TickSize nickel;
+    tf.assert_true("Parse tick size", TickSize::parse("0.05", nickel));
+    nickel.to_ticks("150.27", ticks);
+    tf.assert_equal("150.27 with 0.05 tick", (Price)3005, ticks);
+
+    std::ostringstream out;
+    nickel.write(out, ticks);
+    out << " ";
+    cents.write(out, -5);
+    out << " ";
+    cents.write(out, 0);
+    tf.assert_equal("Tick formatting", std::string("150.25 -0.05 0.00"), out.str());
+
+    // Écriture par tampon : ligne plus longue que le tampon, prix au plus grand nombre de chiffres
+    TickSize atto;
+    TickSize::parse("0.000000000000000001", atto);
+    char longest[TickSize::max_formatted_size];
+    tf.assert_equal("Longest price formatting", std::string("-9.223372036854775808"),
+                    std::string(longest, atto.format(longest, std::numeric_limits<Price>::min())));
+
+    SymbolTable wide_symbols;
+    ExecutionReport report;
+    report.timestamp = 1617278400000000000ULL;
+    report.order_id = 7;
+    report.instrument = wide_symbols.intern(std::string(100, 'X'));
+    report.side = Side::SELL;
+    report.type = OrderType::LIMIT;
+    report.action = Action::NEW;
+    report.status = Status::PARTIALLY_EXECUTED;
+    report.quantity = 40;
+    report.executed_quantity = 60;
+    report.price = 15025;
+    report.execution_price = -3;
+    report.counterparty_id = 18446744073709551615ULL;
+    {
+        BufferedWriter writer(16);
+        writer.open("writer_test.csv");
+        CSVParser::write_report(writer, report, wide_symbols);
+        CSVParser::write_report(writer, report, wide_symbols);
+    }
+    std::ifstream written("writer_test.csv");
+    std::ostringstream content;
+    content << written.rdbuf();
+    std::string row = "1617278400000000000,7," + std::string(100, 'X') +
+                      ",SELL,LIMIT,40,150.25,NEW,PARTIALLY_EXECUTED,60,-0.03,18446744073709551615\n";
+    tf.assert_equal("Buffered rows larger than the buffer", row + row, content.str());
+
+    // Taille de tick par instrument appliquée au parsing
+    std::ofstream file("tick_test.csv");
+    file << "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+    file << "1617278400000000000,1,AAPL,BUY,LIMIT,100,150.27,NEW\n";
+    file << "1617278400000000100,2,EURUSD,BUY,LIMIT,100,1.08345,NEW\n";
+    file.close();
+
+    SymbolTable symbols;
+    TickSize pip;
+    TickSize::parse("0.00001", pip);
+    symbols.set_tick_size("EURUSD", pip);
+    std::vector<Order> orders = CSVParser::parse_input_file("tick_test.csv", symbols);
+    tf.assert_equal("Tick test order count", 2, (int)orders.size());
+    if (orders.size() == 2) {
+        tf.assert_equal("Default tick price", (Price)15027, orders[0].price);
+        tf.assert_equal("Instrument tick price", (Price)108345, orders[1].price);
+    }
+}
+
 void test_csv_parsing_errors(TestFramework& tf) {
     std::cout << "\n=== Testing CSV Parsing Error Handling ===\n";
     
@@ -188,19 +293,174 @@ void test_csv_parsing_errors(TestFramework& tf) {
     error_file << "1617278400000000700,1,AAPL,BUY,LIMIT,200,150.25,NEW\n";   // ID dupliqué
     error_file.close();
     
-    std::vector<Order> orders = CSVParser::parse_input_file("error_test.csv");
+    std::vector<Order> orders = CSVParser::parse_input_file("error_test.csv", test_symbols);
     
     int valid_count = 0, rejected_count = 0;
     for (size_t i = 0; i < orders.size(); ++i) {
-        if (orders[i].status == "REJECTED") {
+        if (orders[i].status == Status::REJECTED) {
             rejected_count++;
         } else {
             valid_count++;
         }
     }
     
-    tf.assert_equal("Valid orders from error test", 1, valid_count);
-    tf.assert_equal("Rejected orders from error test", 7, rejected_count);
+    // Le doublon d'ID passe le parsing : il est rejeté par le moteur
+    tf.assert_equal("Valid orders from error test", 2, valid_count);
+    tf.assert_equal("Rejected orders from error test", 6, rejected_count);
+
+    // Un ordre rejeté restitue ses champs texte d'origine
+    MatchingEngine engine;
+    for (const auto& order : orders) {
+        engine.process_order(order);
+    }
+    CSVParser::write_output_file("error_test.csv", engine.get_all_results(), test_symbols);
+    std::ifstream rejected_file("error_test.csv");
+    std::string line;
+    bool raw_side_kept = false;
+    bool duplicate_rejected = false;
+    while (std::getline(rejected_file, line)) {
+        if (line.rfind("1617278400000000300,4,AAPL,INVALID,LIMIT,40,", 0) == 0) raw_side_kept = true;
+        if (line == "1617278400000000700,1,AAPL,BUY,LIMIT,200,150.25,NEW,REJECTED,0,0.00,0") duplicate_rejected = true;
+    }
+    tf.assert_true("Rejected order keeps raw side text", raw_side_kept);
+    tf.assert_true("Duplicate ID rejected by the engine", duplicate_rejected);
+}
+
+// Découpage en mémoire : fins de ligne CRLF, virgule finale, lignes blanches, dernière ligne sans '\n'
+void test_in_memory_parsing(TestFramework& tf) {
+    std::cout << "\n=== Testing In-Memory CSV Parsing ===\n";
+
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\r\n"
+                       "1617278400000000000,1, AAPL ,buy,LIMIT,100,150.25,NEW\r\n"
+                       "   \n"
+                       "1617278400000000100,2,AAPL,SELL,LIMIT,50,150.25,NEW,\n"
+                       "\n"
+                       "1617278400000000200,3,AAPL,SELL,LIMIT,50,99999999999999999999999,NEW\n"
+                       "1617278400000000300,4,AAPL,SELL,MARKET,30,0,NEW";
+    std::vector<Order> orders;
+    CSVParser::for_each_order_in(text, test_symbols, [&orders](const Order& order) { orders.push_back(order); });
+
+    tf.assert_equal("In-memory order count", 4, (int)orders.size());
+    if (orders.size() != 4) return;
+    tf.assert_true("CRLF line parsed with trimmed fields",
+                   orders[0].status != Status::REJECTED && orders[0].side == Side::BUY &&
+                   test_symbols.name(orders[0].instrument) == "AAPL" && orders[0].price == 15025);
+    tf.assert_true("Trailing comma does not add a field", orders[1].status != Status::REJECTED);
+    tf.assert_true("Overflowing price rejected", orders[2].status == Status::REJECTED);
+    tf.assert_true("Last line without newline parsed",
+                   orders[3].order_id == 4 && orders[3].type == OrderType::MARKET);
+}
+
+// Lecture en flux depuis un tube, par petits blocs (lignes coupées entre deux lectures) : mêmes ordres
+// que la lecture du texte complet, en séquentiel et en parallèle
+void test_streamed_input(TestFramework& tf) {
+    std::cout << "\n=== Testing Streamed Input ===\n";
+
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+    const char* lines[] = {"AAPL,BUY,LIMIT,100,150.25,NEW", "MSFT,sell,LIMIT,50,300.10,NEW",
+                           "AAPL,SELL,MARKET,30,0,NEW", "AAPL,HOLD,LIMIT,10,1.00,NEW", "GOOGL,BUY,LIMIT,-5,10.00,NEW"};
+    for (int i = 1; i <= 300; ++i) {
+        text += std::to_string(1617278400000000000ULL + i * 100) + "," + std::to_string(i % 250 + 1) + "," +
+                lines[i % 5] + (i % 7 == 0 ? "\r\n" : "\n");
+        if (i % 50 == 0) text += "1,2,3\n\n";
+    }
+    text += "1617278400000099999,999,AAPL,BUY,LIMIT,1,150.00,NEW";
+
+    auto describe = [](const Order& order, const SymbolTable& symbols) {
+        return std::to_string(order.order_id) + "|" + std::to_string((int)order.status) + "|" +
+               symbols.name(order.instrument) + "|" + to_string(order.side) + "|" + std::to_string(order.price);
+    };
+    SymbolTable expected_symbols;
+    std::vector<std::string> expected;
+    CSVParser::for_each_order_in(text, expected_symbols, [&](const Order& order) {
+        expected.push_back(describe(order, expected_symbols));
+    });
+
+    for (size_t parse_threads : {1, 2}) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            tf.assert_true("Pipe created", false);
+            return;
+        }
+        std::thread writer([&text, fds]() {
+            for (size_t position = 0; position < text.size(); position += 1000) {
+                size_t size = std::min<size_t>(1000, text.size() - position);
+                if (write(fds[1], text.data() + position, size) != (ssize_t)size) break;
+            }
+            close(fds[1]);
+        });
+
+        MappedFile file;
+        bool opened = file.open("/dev/fd/" + std::to_string(fds[0]));
+        SymbolTable symbols;
+        std::vector<std::string> actual;
+        if (opened && file.is_stream()) {
+            CSVParser::for_each_order_streamed(file, symbols, [&](const Order& order) {
+                actual.push_back(describe(order, symbols));
+            }, parse_threads, 64);
+        }
+        writer.join();
+        close(fds[0]);
+
+        std::string label = parse_threads == 1 ? "Sequential" : "Parallel";
+        tf.assert_true(label + " pipe read as a stream", opened && file.is_stream());
+        tf.assert_true(label + " streamed orders match in-memory parse", actual == expected);
+        // Plus d'une centaine de rejets, quelques textes bruts distincts : conservés une seule fois chacun
+        tf.assert_true(label + " repeated raw texts stored once", symbols.raw_fields_count() <= 8);
+    }
+}
+
+// Chemins du tokenizer (scalaire, SSE2, AVX2) comparés à un découpage naïf, avec des blocs assez
+// petits pour que lignes et champs soient coupés entre deux blocs
+void test_csv_tokenizer_paths(TestFramework& tf) {
+    std::cout << "\n=== Testing CSV Tokenizer Scan Paths ===\n";
+
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\r\n"
+                       "1,2,AAPL,BUY,LIMIT,100,150.25,NEW,\n"
+                       "\n"
+                       ",,,\n"
+                       "a,b,c,d,e,f,g,h,i,j,k\n";
+    std::mt19937 rng(19);
+    const char alphabet[] = "0123456789ABC,,,\n. ";
+    for (int i = 0; i < 2000; ++i) text += alphabet[rng() % (sizeof(alphabet) - 1)];
+    text += "1617278400000000300,4,AAPL,SELL,MARKET,30,0,NEW";
+
+    // Découpage de référence
+    std::vector<std::string> expected;
+    for (size_t start = 0; start < text.size();) {
+        size_t end = std::min(text.find('\n', start), text.size());
+        std::string fields;
+        size_t count = 0;
+        for (size_t field = start; field < end; ++count) {
+            size_t comma = std::min(text.find(',', field), end);
+            if (count < 8) fields += "[" + text.substr(field, comma - field) + "]";
+            field = comma + 1;
+        }
+        expected.push_back(text.substr(start, end - start) + "|" + std::to_string(count) + "|" + fields);
+        start = end + 1;
+    }
+
+    for (CSVTokenizer::ScanPath path : {CSVTokenizer::ScanPath::SCALAR, CSVTokenizer::ScanPath::SSE2,
+                                        CSVTokenizer::ScanPath::AVX2}) {
+        if (!CSVTokenizer::is_supported(path)) continue;
+        bool same = true;
+        for (size_t block : {size_t(7), size_t(33), size_t(1) << 15}) {
+            CSVTokenizer tokenizer(text, path, block);
+            std::string_view line;
+            LineFields fields;
+            size_t index = 0;
+            while (tokenizer.next_line(line, fields)) {
+                std::string actual = std::string(line) + "|" + std::to_string(fields.count) + "|";
+                for (size_t i = 0; i < std::min<size_t>(fields.count, 8); ++i) {
+                    actual += "[" + std::string(fields[i]) + "]";
+                }
+                same = same && index < expected.size() && actual == expected[index];
+                index++;
+            }
+            same = same && index == expected.size();
+        }
+        tf.assert_true(std::string("Tokenizer ") + CSVTokenizer::path_name(path) + " matches naive split", same);
+    }
 }
 
 void test_order_book_matching(TestFramework& tf) {
@@ -209,22 +469,22 @@ void test_order_book_matching(TestFramework& tf) {
     MatchingEngine engine;
     
     // Test d'un matching de base
-    Order buy1 = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
-    Order sell1 = create_order(1617278400000000100ULL, 2, "AAPL", "SELL", "LIMIT", 50, 150.25, "NEW");
+    Order buy1 = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+    Order sell1 = create_order(1617278400000000100ULL, 2, "AAPL", "SELL", "LIMIT", 50, 15025, "NEW");
     
     engine.process_order(buy1);
     engine.process_order(sell1);
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     
     tf.assert_equal("Basic matching result count", 3, (int)results.size());
     
     bool found_executed_sell = false, found_partial_buy = false;
     for (size_t i = 0; i < results.size(); ++i) {
-        if (results[i].order_id == 2 && results[i].status == "EXECUTED") {
+        if (results[i].order_id == 2 && results[i].status == Status::EXECUTED) {
             found_executed_sell = true;
         }
-        if (results[i].order_id == 1 && results[i].status == "PARTIALLY_EXECUTED") {
+        if (results[i].order_id == 1 && results[i].status == Status::PARTIALLY_EXECUTED) {
             found_partial_buy = true;
         }
     }
@@ -239,22 +499,22 @@ void test_modify_order_behavior(TestFramework& tf) {
     MatchingEngine engine;
     
     // Création de l'ordre initial
-    Order initial = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
+    Order initial = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
     engine.process_order(initial);
     
     // Execution partielle
-    Order sell1 = create_order(1617278400000000100ULL, 2, "AAPL", "SELL", "LIMIT", 50, 150.25, "NEW");
+    Order sell1 = create_order(1617278400000000100ULL, 2, "AAPL", "SELL", "LIMIT", 50, 15025, "NEW");
     engine.process_order(sell1);
     
     // Modification de l'ordre initial
-    Order modify = create_order(1617278400000000200ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.30, "MODIFY");
+    Order modify = create_order(1617278400000000200ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15030, "MODIFY");
     engine.process_order(modify);
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     
     bool found_modify_pending = false;
     for (size_t i = 0; i < results.size(); ++i) {
-        if (results[i].action == "MODIFY" && results[i].order_id == 1) {
+        if (results[i].action == Action::MODIFY && results[i].order_id == 1) {
             found_modify_pending = true;
         }
     }
@@ -262,23 +522,74 @@ void test_modify_order_behavior(TestFramework& tf) {
     tf.assert_true("Found MODIFY action result", found_modify_pending);
 }
 
+void test_modify_priority(TestFramework& tf) {
+    std::cout << "\n=== Testing MODIFY Priority ===\n";
+
+    MatchingEngine engine;
+    uint64_t timestamp = 1617278400000000000ULL;
+    engine.process_order(create_order(timestamp += 100, 1, "AAPL", "BUY", "LIMIT", 100, 15000, "NEW"));
+    engine.process_order(create_order(timestamp += 100, 2, "AAPL", "BUY", "LIMIT", 100, 15000, "NEW"));
+    engine.process_order(create_order(timestamp += 100, 3, "AAPL", "BUY", "LIMIT", 100, 15000, "NEW"));
+    // Exécution partielle de l'ordre 1 (30 sur 100)
+    engine.process_order(create_order(timestamp += 100, 4, "AAPL", "SELL", "LIMIT", 30, 15000, "NEW"));
+    engine.clear_results();
+
+    // Baisse au même prix : quantité totale 50, soit 20 restants, priorité conservée
+    engine.process_order(create_order(timestamp += 100, 1, "AAPL", "BUY", "LIMIT", 50, 15000, "MODIFY"));
+    std::vector<ExecutionReport> results = engine.get_all_results();
+    tf.assert_true("Quantity decrease acknowledged as pending",
+                   results.size() == 1 && results[0].status == Status::PENDING && results[0].action == Action::MODIFY &&
+                   results[0].quantity == 50 && results[0].price == 15000);
+    // Hausse de quantité : l'ordre 2 repasse en fin de file
+    engine.process_order(create_order(timestamp += 100, 2, "AAPL", "BUY", "LIMIT", 150, 15000, "MODIFY"));
+    engine.clear_results();
+
+    engine.process_order(create_order(timestamp += 100, 5, "AAPL", "SELL", "LIMIT", 130, 15000, "NEW"));
+    results = engine.get_all_results();
+    std::vector<uint64_t> counterparties;
+    std::vector<uint64_t> quantities;
+    for (const ExecutionReport& report : results) {
+        if (report.order_id == 5) {
+            counterparties.push_back(report.counterparty_id);
+            quantities.push_back(report.executed_quantity);
+        }
+    }
+    tf.assert_true("Reduced order keeps its place, increased order goes last",
+                   counterparties == std::vector<uint64_t>({1, 3, 2}));
+    tf.assert_true("Reduced order fills only its remaining quantity", quantities == std::vector<uint64_t>({20, 100, 10}));
+
+    // Total de la limite après une baisse sur place : ordre intact puis ordre partiellement exécuté
+    OrderBook book;
+    book.add_order(create_order(timestamp += 100, 10, "AAPL", "BUY", "LIMIT", 100, 15000, "NEW"));
+    book.add_order(create_order(timestamp += 100, 11, "AAPL", "BUY", "LIMIT", 100, 14900, "NEW"));
+    book.modify_order(create_order(timestamp += 100, 10, "AAPL", "BUY", "LIMIT", 60, 15000, "MODIFY"));
+    tf.assert_equal("Level total after reducing an unfilled order", uint64_t(60), book.resting_quantity(Side::BUY, 15000));
+    book.add_order(create_order(timestamp += 100, 12, "AAPL", "SELL", "LIMIT", 40, 14900, "NEW"));
+    tf.assert_equal("Level total after partial fill", uint64_t(20), book.resting_quantity(Side::BUY, 15000));
+    tf.assert_equal("Second level untouched", uint64_t(100), book.resting_quantity(Side::BUY, 14900));
+    book.modify_order(create_order(timestamp += 100, 10, "AAPL", "BUY", "LIMIT", 50, 15000, "MODIFY"));
+    tf.assert_equal("Level total after reducing a partially filled order", uint64_t(10), book.resting_quantity(Side::BUY, 15000));
+    book.cancel_order(create_order(timestamp += 100, 10, "AAPL", "BUY", "LIMIT", 0, 0, "CANCEL"));
+    tf.assert_equal("Level emptied by cancel after reduces", uint64_t(0), book.resting_quantity(Side::BUY, 15000));
+}
+
 void test_cancel_order_behavior(TestFramework& tf) {
     std::cout << "\n=== Testing CANCEL Order Behavior ===\n";
     
     MatchingEngine engine;
     
     // Création et suppression d'un ordre
-    Order initial = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
+    Order initial = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
     Order cancel = create_order(1617278400000000100ULL, 1, "AAPL", "BUY", "LIMIT", 100, 0, "CANCEL");
     
     engine.process_order(initial);
     engine.process_order(cancel);
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     
     bool found_canceled = false;
     for (size_t i = 0; i < results.size(); ++i) {
-        if (results[i].action == "CANCEL" && results[i].status == "CANCELED") {
+        if (results[i].action == Action::CANCEL && results[i].status == Status::CANCELED) {
             found_canceled = true;
         }
     }
@@ -286,28 +597,293 @@ void test_cancel_order_behavior(TestFramework& tf) {
     tf.assert_true("Found CANCEL action result", found_canceled);
 }
 
+void test_cancel_preserves_time_priority(TestFramework& tf) {
+    std::cout << "\n=== Testing CANCEL Preserves Time Priority ===\n";
+
+    MatchingEngine engine;
+
+    // Trois ordres BUY sur la même limite de prix
+    engine.process_order(create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+    engine.process_order(create_order(1617278400000000100ULL, 2, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+    engine.process_order(create_order(1617278400000000200ULL, 3, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+
+    // Annulation de l'ordre au milieu de la file
+    engine.process_order(create_order(1617278400000000300ULL, 2, "AAPL", "BUY", "LIMIT", 100, 15025, "CANCEL"));
+
+    // Un SELL qui consomme les deux ordres restants
+    engine.process_order(create_order(1617278400000000400ULL, 4, "AAPL", "SELL", "LIMIT", 200, 15025, "NEW"));
+
+    std::vector<ExecutionReport> results = engine.get_all_results();
+
+    std::vector<uint64_t> counterparties;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].order_id == 4) {
+            counterparties.push_back(results[i].counterparty_id);
+        }
+    }
+
+    tf.assert_equal("Fills after cancel", 2, (int)counterparties.size());
+    if (counterparties.size() == 2) {
+        tf.assert_equal("First fill keeps priority", (uint64_t)1, counterparties[0]);
+        tf.assert_equal("Second fill skips canceled order", (uint64_t)3, counterparties[1]);
+    }
+
+    // L'ordre annulé ne peut plus être annulé
+    engine.clear_results();
+    engine.process_order(create_order(1617278400000000500ULL, 2, "AAPL", "BUY", "LIMIT", 100, 15025, "CANCEL"));
+    results = engine.get_all_results();
+    tf.assert_true("Second cancel rejected", results.size() == 1 && results[0].status == Status::REJECTED);
+}
+
 void test_duplicate_order_handling(TestFramework& tf) {
     std::cout << "\n=== Testing Duplicate Order Handling ===\n";
     
     MatchingEngine engine;
     
-    Order order1 = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
-    Order order2 = create_order(1617278400000000100ULL, 1, "AAPL", "BUY", "LIMIT", 200, 150.20, "NEW"); // Same ID
+    Order order1 = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+    Order order2 = create_order(1617278400000000100ULL, 1, "AAPL", "BUY", "LIMIT", 200, 15020, "NEW"); // Same ID
     
     engine.process_order(order1);
     engine.process_order(order2);
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     
     bool found_rejected = false;
     for (size_t i = 0; i < results.size(); ++i) {
-        if (results[i].order_id == 1 && results[i].status == "REJECTED" && 
+        if (results[i].order_id == 1 && results[i].status == Status::REJECTED && 
             results[i].timestamp == order2.timestamp) {
             found_rejected = true;
         }
     }
     
     tf.assert_true("Duplicate order rejected", found_rejected);
+
+    // Index commun aux carnets : un ID ne sert qu'à un instrument, et une annulation qui ne nomme pas
+    // l'instrument de l'ordre est rejetée sans toucher au carnet de l'ordre
+    Order other_book = create_order(1617278400000000200ULL, 1, "MSFT", "SELL", "LIMIT", 10, 30000, "NEW");
+    Order wrong_book_cancel = create_order(1617278400000000300ULL, 1, "MSFT", "BUY", "LIMIT", 0, 0, "CANCEL");
+    Order cancel = create_order(1617278400000000400ULL, 1, "AAPL", "BUY", "LIMIT", 0, 0, "CANCEL");
+    engine.process_order(other_book);
+    engine.process_order(wrong_book_cancel);
+    engine.process_order(cancel);
+    results = engine.get_all_results();
+    auto status_at = [&results](uint64_t timestamp) {
+        for (const ExecutionReport& report : results) {
+            if (report.timestamp == timestamp) return report.status;
+        }
+        return Status::NONE;
+    };
+    tf.assert_true("Duplicate ID on another instrument rejected", status_at(other_book.timestamp) == Status::REJECTED);
+    tf.assert_true("Cancel on another instrument rejected", status_at(wrong_book_cancel.timestamp) == Status::REJECTED);
+    tf.assert_true("Cancel on the order's instrument applied", status_at(cancel.timestamp) == Status::CANCELED);
+}
+
+void test_price_ladder_matches_tree(TestFramework& tf) {
+    std::cout << "\n=== Testing Dense Price Ladder Against Tree ===\n";
+
+    // Même flux sur un carnet en arbre et sur une petite échelle (recentrages fréquents)
+    OrderBook tree_book;
+    OrderBook ladder_book(64);
+
+    uint64_t seed = 12345;
+    auto next_random = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed >> 33;
+    };
+
+    Price mid = 15000;
+    uint64_t timestamp = 1617278400000000000ULL;
+    for (uint64_t i = 1; i <= 5000; ++i) {
+        if (i % 250 == 0) mid += (Price)(next_random() % 201) - 100;
+        bool buy = next_random() & 1;
+        Price price = mid + (Price)(next_random() % 81) - 40;
+        uint64_t action = next_random() % 10;
+        if (action < 6 || i < 10) {
+            Order order = create_order(timestamp += 100, i, "AAPL", buy ? "BUY" : "SELL",
+                                       (next_random() % 20 == 0) ? "MARKET" : "LIMIT", 1 + next_random() % 100, price, "NEW");
+            tree_book.add_order(order);
+            ladder_book.add_order(order);
+        } else if (action < 9) {
+            Order order = create_order(timestamp += 100, 1 + next_random() % i, "AAPL", "BUY", "LIMIT", 1, 0, "CANCEL");
+            tree_book.cancel_order(order);
+            ladder_book.cancel_order(order);
+        } else {
+            Order order = create_order(timestamp += 100, 1 + next_random() % i, "AAPL", "BUY", "LIMIT", 1 + next_random() % 100, price, "MODIFY");
+            tree_book.modify_order(order);
+            ladder_book.modify_order(order);
+        }
+    }
+
+    // Comparaison dans l'ordre d'émission (les horodatages d'exécution sont globaux)
+    const std::vector<ExecutionReport>& tree_results = tree_book.results;
+    const std::vector<ExecutionReport>& ladder_results = ladder_book.results;
+    bool identical = tree_results.size() == ladder_results.size();
+    for (size_t i = 0; identical && i < tree_results.size(); ++i) {
+        const ExecutionReport& a = tree_results[i];
+        const ExecutionReport& b = ladder_results[i];
+        identical = a.order_id == b.order_id && a.status == b.status && a.action == b.action &&
+                    a.quantity == b.quantity && a.price == b.price && a.executed_quantity == b.executed_quantity &&
+                    a.execution_price == b.execution_price && a.counterparty_id == b.counterparty_id;
+    }
+    tf.assert_true("Ladder produces the same results as tree", identical);
+    tf.assert_true("Ladder flow generated executions", tree_results.size() > 5000);
+}
+
+void test_book_pool_allocations(TestFramework& tf) {
+    std::cout << "\n=== Testing Order Book Pool Allocations ===\n";
+
+    OrderBook book;
+    book.reserve(20000, 256);
+    book.results.reserve(100000);
+    uint64_t allocations_after_reserve = book.allocation_count();
+
+    // Flux ajout / exécution / annulation dans les volumes réservés
+    uint64_t timestamp = 1617278400000000000ULL;
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        Price price = 15000 + (Price)(i % 50);
+        if (i % 4 == 3) {
+            book.cancel_order(create_order(timestamp += 100, i - 2, "AAPL", "BUY", "LIMIT", 1, 0, "CANCEL"));
+        } else {
+            book.add_order(create_order(timestamp += 100, i, "AAPL", (i % 2) ? "BUY" : "SELL", "LIMIT", 10 + i % 7, price, "NEW"));
+        }
+        if (book.results.size() > 90000) book.clear_results();
+    }
+
+    tf.assert_true("Reserve allocated pool memory", allocations_after_reserve > 0);
+    tf.assert_equal("No heap allocation after reserve", allocations_after_reserve, book.allocation_count());
+
+    // Sans réservation : les noeuds libérés sont réutilisés, les tranches restent rares
+    OrderBook unreserved;
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        unreserved.add_order(create_order(timestamp += 100, i, "AAPL", "BUY", "LIMIT", 10, 15000, "NEW"));
+        unreserved.cancel_order(create_order(timestamp += 100, i, "AAPL", "BUY", "LIMIT", 1, 0, "CANCEL"));
+    }
+    tf.assert_true("Slab allocations amortized", unreserved.allocation_count() < 200);
+
+    // Cancel/replace sur une file courte : l'index se compacte sur place, les tombes restent dans leur bitmap
+    MatchingEngine engine;
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> resting_ids;
+    uint64_t next_id = 1;
+    for (; next_id <= 10; ++next_id) {
+        engine.process_order(create_order(timestamp += 100, next_id, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+        resting_ids.push_back(next_id);
+    }
+    uint64_t allocations_after_warmup = 0;
+    for (size_t i = 0; i < 30000; ++i) {
+        // Échauffement : plus de 4096 IDs retirés, le bloc de tombes est passé en bitmap
+        if (i == 10000) allocations_after_warmup = engine.book_allocation_count();
+        size_t slot = rng() % resting_ids.size();
+        engine.process_order(create_order(timestamp += 100, resting_ids[slot], "AAPL", "BUY", "LIMIT", 0, 0, "CANCEL"));
+        engine.process_order(create_order(timestamp += 100, next_id, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+        resting_ids[slot] = next_id++;
+        if ((i & 1023) == 1023) engine.clear_results();
+    }
+    tf.assert_true("Cancel/replace IDs retired", engine.get_order_index().retired_count() >= 29000);
+    tf.assert_equal("No heap allocation on shallow cancel/replace", allocations_after_warmup,
+                    engine.book_allocation_count());
+}
+
+void test_order_index(TestFramework& tf) {
+    std::cout << "\n=== Testing Order Index ===\n";
+
+    BookArena arena;
+    OrderIndex index(arena);
+
+    // IDs dispersés, avec plusieurs agrandissements de la table
+    for (uint64_t i = 0; i < 5000; ++i) {
+        index.insert(i * 7919).total_executed = i;
+    }
+
+    bool all_found = true;
+    for (uint64_t i = 0; i < 5000; ++i) {
+        OrderSlot* slot = index.find(i * 7919);
+        all_found = all_found && slot != nullptr && slot->total_executed == i && slot->status == Status::PENDING;
+    }
+    bool none_spurious = true;
+    for (uint64_t i = 0; i < 5000; ++i) {
+        none_spurious = none_spurious && index.find(i * 7919 + 1) == nullptr;
+    }
+
+    tf.assert_equal("Index size", 5000, (int)index.size());
+    tf.assert_true("All inserted IDs found after growth", all_found);
+    tf.assert_true("Unknown IDs not found", none_spurious);
+}
+
+void test_order_retention(TestFramework& tf) {
+    std::cout << "\n=== Testing Order Retention ===\n";
+
+    // Tombes : blocs creux, puis en bitmap au-delà de 4096 IDs
+    BookArena tombstone_arena;
+    TombstoneSet tombstones(tombstone_arena);
+    for (uint64_t id = 0; id < 70000; ++id) tombstones.insert(id);
+    for (uint64_t id = 0; id < 1000; ++id) tombstones.insert(((id + 1) * 2654435761ULL) << 20);
+    tombstones.insert(42);
+    bool all_present = true;
+    for (uint64_t id = 0; id < 70000; ++id) all_present = all_present && tombstones.contains(id);
+    for (uint64_t id = 0; id < 1000; ++id) all_present = all_present && tombstones.contains(((id + 1) * 2654435761ULL) << 20);
+    tf.assert_true("Tombstones contain every inserted ID", all_present);
+    tf.assert_true("Tombstones reject unknown IDs", !tombstones.contains(70000) && !tombstones.contains((3ULL << 20) + 1));
+    tf.assert_equal("Tombstone count ignores repeats", 71000, (int)tombstones.size());
+
+    // Flux long d'ordres annulés ou exécutés : la table reste à la taille des ordres vivants
+    MatchingEngine engine;
+    uint64_t timestamp = 1617278400000000000ULL;
+    for (uint64_t i = 1; i <= 20000; ++i) {
+        engine.process_order(create_order(timestamp += 100, i, "AAPL", "BUY", "LIMIT", 10, 15000 - (i % 50), "NEW"));
+        if (i % 4 == 0) {
+            engine.process_order(create_order(timestamp += 100, i, "AAPL", "SELL", "LIMIT", 0, 0, "CANCEL"));
+        }
+        if (i > 16 && i % 4 != 0) {
+            engine.process_order(create_order(timestamp += 100, i - 16, "AAPL", "BUY", "LIMIT", 0, 0, "CANCEL"));
+        }
+    }
+    // Un ordre au repos, puis exécuté entièrement par un vendeur plus gros (qui reste au repos)
+    engine.process_order(create_order(timestamp += 100, 30000, "AAPL", "BUY", "LIMIT", 10, 16000, "NEW"));
+    engine.process_order(create_order(timestamp += 100, 30001, "AAPL", "SELL", "LIMIT", 20, 16000, "NEW"));
+    for (uint64_t i = 0; i < 100; ++i) {
+        engine.process_order(create_order(timestamp += 100, 40000 + i, "AAPL", "SELL", "LIMIT", 1, 17000, "NEW"));
+    }
+    const OrderIndex& index = engine.get_order_index();
+    tf.assert_true("Terminal orders retired", index.retired_count() >= 19900);
+    tf.assert_true("Index table bounded by live orders", index.capacity() <= 512);
+    engine.clear_results();
+
+    engine.process_order(create_order(timestamp += 100, 5, "AAPL", "BUY", "LIMIT", 10, 15000, "NEW"));
+    engine.process_order(create_order(timestamp += 100, 30000, "AAPL", "SELL", "LIMIT", 10, 15000, "NEW"));
+    engine.process_order(create_order(timestamp += 100, 8, "AAPL", "BUY", "LIMIT", 0, 0, "CANCEL"));
+    engine.process_order(create_order(timestamp += 100, 9, "AAPL", "BUY", "LIMIT", 20, 15000, "MODIFY"));
+    engine.process_order(create_order(timestamp += 100, 30001, "AAPL", "SELL", "LIMIT", 0, 0, "CANCEL"));
+    std::vector<ExecutionReport> results = engine.get_all_results();
+    tf.assert_equal("Retired IDs answered", 5, (int)results.size());
+    bool retired_rejected = results.size() == 5;
+    for (size_t i = 0; i < 4 && i < results.size(); ++i) {
+        retired_rejected = retired_rejected && results[i].status == Status::REJECTED;
+    }
+    tf.assert_true("Retired IDs rejected for NEW, CANCEL and MODIFY", retired_rejected);
+    tf.assert_true("Live order still cancelable", results.size() == 5 && results[4].status == Status::CANCELED);
+
+    // Flux d'agressifs exécutés entièrement à leur arrivée et d'ordres MARKET : terminés, retirés eux aussi
+    MatchingEngine fills;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        fills.process_order(create_order(timestamp += 100, 3 * i + 1, "AAPL", "SELL", "LIMIT", 20, 15000, "NEW"));
+        fills.process_order(create_order(timestamp += 100, 3 * i + 2, "AAPL", "BUY", "LIMIT", 10, 15000, "NEW"));
+        fills.process_order(create_order(timestamp += 100, 3 * i + 3, "AAPL", "BUY", "MARKET", 10, 0, "NEW"));
+    }
+    const OrderIndex& fill_index = fills.get_order_index();
+    tf.assert_true("Filled aggressors and market orders retired", fill_index.retired_count() >= 59000);
+    tf.assert_true("Index table bounded on fill-heavy flow", fill_index.capacity() <= 512);
+    fills.clear_results();
+
+    fills.process_order(create_order(timestamp += 100, 59999, "AAPL", "BUY", "LIMIT", 0, 0, "CANCEL"));
+    fills.process_order(create_order(timestamp += 100, 60000, "AAPL", "BUY", "MARKET", 20, 0, "MODIFY"));
+    fills.process_order(create_order(timestamp += 100, 2, "AAPL", "BUY", "LIMIT", 20, 15000, "MODIFY"));
+    results = fills.get_all_results();
+    bool terminal_rejected = results.size() == 3;
+    for (const ExecutionReport& report : results) {
+        terminal_rejected = terminal_rejected && report.status == Status::REJECTED;
+    }
+    tf.assert_true("Filled aggressor and market order rejected for CANCEL and MODIFY", terminal_rejected);
 }
 
 void test_multi_instrument_support(TestFramework& tf) {
@@ -315,18 +891,18 @@ void test_multi_instrument_support(TestFramework& tf) {
     
     MatchingEngine engine;
     
-    Order aapl_buy = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
-    Order googl_sell = create_order(1617278400000000100ULL, 2, "GOOGL", "SELL", "LIMIT", 100, 150.25, "NEW");
+    Order aapl_buy = create_order(1617278400000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+    Order googl_sell = create_order(1617278400000000100ULL, 2, "GOOGL", "SELL", "LIMIT", 100, 15025, "NEW");
     
     engine.process_order(aapl_buy);
     engine.process_order(googl_sell);
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     
     bool found_aapl = false, found_googl = false;
     for (size_t i = 0; i < results.size(); ++i) {
-        if (results[i].instrument == "AAPL") found_aapl = true;
-        if (results[i].instrument == "GOOGL") found_googl = true;
+        if (test_symbols.name(results[i].instrument) == "AAPL") found_aapl = true;
+        if (test_symbols.name(results[i].instrument) == "GOOGL") found_googl = true;
     }
     
     tf.assert_true("Found AAPL order", found_aapl);
@@ -334,21 +910,468 @@ void test_multi_instrument_support(TestFramework& tf) {
     tf.assert_equal("Multi-instrument isolation", 2, (int)results.size());
 }
 
+// Sink de test : conserve les événements reçus
+class CollectingSink : public ResultSink {
+public:
+    std::vector<ExecutionReport> reports;
+    void on_report(const ExecutionReport& report) override { reports.push_back(report); }
+};
+
+void test_result_sink(TestFramework& tf) {
+    std::cout << "\n=== Testing Result Sink Streaming ===\n";
+
+    // Horodatages espacés : l'ordre trié de get_all_results coïncide avec l'ordre d'émission
+    std::vector<Order> orders;
+    orders.push_back(create_order(1700000000000000000ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW"));
+    orders.push_back(create_order(1700000000001000000ULL, 2, "GOOGL", "SELL", "LIMIT", 10, 28000, "NEW"));
+    orders.push_back(create_order(1700000000002000000ULL, 3, "AAPL", "SELL", "LIMIT", 60, 15020, "NEW"));
+    orders.push_back(create_order(1700000000003000000ULL, 1, "AAPL", "BUY", "LIMIT", 0, 15025, "CANCEL"));
+    orders.push_back(create_order(1700000000004000000ULL, 9, "AAPL", "BUY", "LIMIT", 0, 15025, "CANCEL"));
+
+    MatchingEngine accumulating;
+    MatchingEngine streaming;
+    CollectingSink sink;
+    streaming.set_sink(&sink);
+    for (const auto& order : orders) {
+        accumulating.process_order(order);
+        streaming.process_order(order);
+    }
+
+    std::vector<ExecutionReport> expected = accumulating.get_all_results();
+    bool same = expected.size() == sink.reports.size();
+    for (size_t i = 0; same && i < expected.size(); ++i) {
+        same = expected[i].order_id == sink.reports[i].order_id && expected[i].status == sink.reports[i].status &&
+               expected[i].quantity == sink.reports[i].quantity &&
+               expected[i].executed_quantity == sink.reports[i].executed_quantity;
+    }
+    tf.assert_true("Sink receives every event in emission order", same);
+    tf.assert_true("Nothing accumulated with a sink", streaming.get_all_results().empty());
+}
+
+// Flux aléatoire multi-instruments (NEW / MODIFY / CANCEL, LIMIT et MARKET)
+std::vector<Order> random_order_flow(unsigned seed, size_t count) {
+    const char* instruments[] = {"AAPL", "GOOGL", "MSFT", "TSLA", "AMZN"};
+    std::mt19937 rng(seed);
+    std::vector<Order> orders;
+    for (uint64_t i = 0; i < count; ++i) {
+        // Timestamps serrés (50 ns) : l'horloge des exécutions (+100 ns) est sollicitée
+        uint64_t id = 1 + rng() % 1500;
+        const char* action = (i % 7 == 3) ? "CANCEL" : (i % 5 == 2) ? "MODIFY" : "NEW";
+        const char* type = (rng() % 10 == 0) ? "MARKET" : "LIMIT";
+        orders.push_back(create_order(1700000000000000000ULL + i * 50, id, instruments[rng() % 5],
+                                      (rng() % 2) ? "BUY" : "SELL", type, 1 + rng() % 200,
+                                      10000 + rng() % 20, action));
+    }
+    return orders;
+}
+
+bool same_reports(const std::vector<ExecutionReport>& a, const std::vector<ExecutionReport>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].timestamp != b[i].timestamp || a[i].order_id != b[i].order_id ||
+            a[i].counterparty_id != b[i].counterparty_id || a[i].quantity != b[i].quantity ||
+            a[i].executed_quantity != b[i].executed_quantity || a[i].price != b[i].price ||
+            a[i].execution_price != b[i].execution_price || a[i].instrument != b[i].instrument ||
+            a[i].side != b[i].side || a[i].action != b[i].action || a[i].status != b[i].status) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Lecture parallèle par petits blocs : mêmes ordres, mêmes avertissements que la lecture séquentielle
+void test_parallel_parsing(TestFramework& tf) {
+    std::cout << "\n=== Testing Parallel CSV Parsing ===\n";
+
+    std::mt19937 rng(5);
+    const char* lines[] = {"%llu,%llu,AAPL,BUY,LIMIT,10,150.25,NEW", "%llu,%llu,NEWSYM%llu,sell,LIMIT,5,150.20,NEW",
+                           "%llu,%llu,AAPL,BUY,LIMIT,10", "%llu,%llu,MSFT,Hold,LIMIT,5,1.00,NEW",
+                           "%llu,%llu,MSFT,BUY,MARKET,5,0,CANCEL", "   "};
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+    char buffer[128];
+    for (unsigned long long i = 0; i < 3000; ++i) {
+        // IDs répétés : doublons de part et d'autre des frontières de blocs
+        std::snprintf(buffer, sizeof(buffer), lines[rng() % 6], 1617278400000000000ULL + i, 1 + rng() % 2000, i % 50);
+        text += buffer;
+        text += "\n";
+    }
+
+    // Avertissements capturés pour comparer les numéros de ligne
+    auto parse = [&text](size_t threads, std::vector<Order>& orders, std::string& warnings, SymbolTable& symbols) {
+        std::ostringstream captured;
+        std::streambuf* previous = std::cerr.rdbuf(captured.rdbuf());
+        CSVParser::for_each_order_in(text, symbols, [&orders](const Order& order) { orders.push_back(order); },
+                                     threads, 512);
+        std::cerr.rdbuf(previous);
+        warnings = captured.str();
+    };
+
+    SymbolTable serial_symbols;
+    SymbolTable parallel_symbols;
+    std::vector<Order> serial_orders, parallel_orders;
+    std::string serial_warnings, parallel_warnings;
+    parse(1, serial_orders, serial_warnings, serial_symbols);
+    parse(3, parallel_orders, parallel_warnings, parallel_symbols);
+
+    bool same = serial_orders.size() == parallel_orders.size();
+    for (size_t i = 0; same && i < serial_orders.size(); ++i) {
+        const Order& a = serial_orders[i];
+        const Order& b = parallel_orders[i];
+        same = a.timestamp == b.timestamp && a.order_id == b.order_id && a.quantity == b.quantity &&
+               a.price == b.price && a.side == b.side && a.status == b.status &&
+               serial_symbols.name(a.instrument) == parallel_symbols.name(b.instrument) &&
+               (a.raw_text == 0) == (b.raw_text == 0) &&
+               (a.raw_text == 0 || serial_symbols.get_raw_fields(a.raw_text).side ==
+                                   parallel_symbols.get_raw_fields(b.raw_text).side);
+    }
+    tf.assert_true("Parallel parse yields the same orders in file order", same && !serial_orders.empty());
+    tf.assert_true("Parallel parse reports the same warnings and line numbers",
+                   serial_warnings == parallel_warnings && !serial_warnings.empty());
+}
+
+// Pipeline lecture / matching / écriture : fichier de sortie identique à l'exécution séquentielle
+void test_pipeline(TestFramework& tf) {
+    std::cout << "\n=== Testing Pipelined Execution ===\n";
+
+    std::mt19937 rng(11);
+    const char* lines[] = {"%llu,%llu,AAPL,BUY,LIMIT,%llu,150.2%llu,NEW", "%llu,%llu,NEWSYM%llu,sell,LIMIT,5,150.20,NEW",
+                           "%llu,%llu,AAPL,Sell,LIMIT,%llu,150.2%llu,MODIFY", "%llu,%llu,MSFT,Hold,LIMIT,5,1.00,NEW",
+                           "%llu,%llu,AAPL,BUY,MARKET,0,0,CANCEL"};
+    std::ofstream file("pipeline_test.csv");
+    file << "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+    char buffer[128];
+    for (unsigned long long i = 0; i < 5000; ++i) {
+        // Nouveaux instruments et rejets au fil du fichier : la table d'écriture doit suivre
+        std::snprintf(buffer, sizeof(buffer), lines[rng() % 5], 1617278400000000000ULL + i * 50,
+                      1 + rng() % 1500, i % 300 == 0 ? i : 1 + rng() % 100, rng() % 10);
+        file << buffer << "\n";
+    }
+    file.close();
+
+    auto read_all = [](const std::string& filename) {
+        std::ifstream in(filename);
+        std::ostringstream content;
+        content << in.rdbuf();
+        return content.str();
+    };
+
+    {
+        SymbolTable symbols;
+        CSVSink sink("pipeline_serial_output.csv", symbols);
+        MatchingEngine engine;
+        engine.set_sink(&sink);
+        CSVParser::for_each_order("pipeline_test.csv", symbols, [&](const Order& order) {
+            engine.process_order(order);
+        });
+        sink.flush();
+    }
+    for (size_t shard_count : {1, 2}) {
+        // Petits lots peu nombreux : les tampons sont recyclés de nombreuses fois
+        SymbolTable symbols;
+        MatchingPipeline pipeline(symbols, 64, 3);
+        CSVSink sink("pipeline_output.csv", pipeline.output_symbols());
+        MatchingEngine engine;
+        ShardedMatchingEngine sharded(shard_count, pipeline.engine_sink());
+        engine.set_sink(&pipeline.engine_sink());
+        pipeline.run("pipeline_test.csv", 1, sink,
+            [&](const Order* orders, size_t count) {
+                if (shard_count > 1) sharded.process_batch(orders, count);
+                else engine.process_batch(orders, count);
+            },
+            [&]() {
+                if (shard_count > 1) sharded.finish();
+            });
+        tf.assert_equal("Pipeline order count", 5000, (int)pipeline.order_count());
+        tf.assert_true("Pipeline output matches serial output (" + std::to_string(shard_count) + " matching threads)",
+                       read_all("pipeline_output.csv") == read_all("pipeline_serial_output.csv"));
+    }
+}
+
+// Aller-retour par le format binaire : mêmes ordres, instruments et textes bruts qu'à la lecture du CSV
+void test_binary_orders(TestFramework& tf) {
+    std::cout << "\n=== Testing Binary Order Files ===\n";
+
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\n"
+                       "1617278400000000000,1,AAPL,BUY,LIMIT,100,150.25,NEW\n"
+                       "1617278400000000100,2,EURUSD,sell,LIMIT,50,1.08345,NEW\n"
+                       "1617278400000000200,3,AAPL,Hold,LIMIT,5,150.00,NEW\n"
+                       "1617278400000000300,1,AAPL,BUY,LIMIT,100,150.30,MODIFY\n"
+                       "1617278400000000400,2,EURUSD,SELL,MARKET,0,0,CANCEL\n";
+    SymbolTable csv_symbols;
+    TickSize pip;
+    TickSize::parse("0.00001", pip);
+    csv_symbols.set_tick_size("EURUSD", pip);
+    std::vector<Order> csv_orders;
+    BinaryOrderWriter writer;
+    writer.open("orders_test.bin");
+    CSVParser::for_each_order_in(text, csv_symbols, [&](const Order& order) {
+        csv_orders.push_back(order);
+        writer.write(order);
+    });
+    writer.close(csv_symbols);
+
+    // Table déjà peuplée : identifiants et références du fichier remappés
+    SymbolTable symbols;
+    symbols.intern("MSFT");
+    symbols.store_raw_fields("x", "y", "z");
+    std::vector<Order> orders;
+    bool opened = BinaryOrderFile::for_each_order("orders_test.bin", symbols,
+                                                  [&orders](const Order& order) { orders.push_back(order); });
+
+    bool same = opened && orders.size() == csv_orders.size();
+    for (size_t i = 0; same && i < orders.size(); ++i) {
+        const Order& a = csv_orders[i];
+        const Order& b = orders[i];
+        same = a.timestamp == b.timestamp && a.order_id == b.order_id && a.quantity == b.quantity &&
+               a.price == b.price && a.side == b.side && a.type == b.type && a.action == b.action &&
+               a.status == b.status && csv_symbols.name(a.instrument) == symbols.name(b.instrument) &&
+               csv_symbols.tick_size(a.instrument).decimals == symbols.tick_size(b.instrument).decimals &&
+               (a.raw_text == 0) == (b.raw_text == 0) &&
+               (a.raw_text == 0 || csv_symbols.get_raw_fields(a.raw_text).side ==
+                                   symbols.get_raw_fields(b.raw_text).side);
+    }
+    tf.assert_true("Binary file replays the parsed orders", same);
+    tf.assert_equal("Rejected order keeps its raw text", std::string("HOLD"),
+                    orders.size() > 2 ? symbols.get_raw_fields(orders[2].raw_text).side : std::string());
+
+    bool rejected = false;
+    try {
+        BinaryOrderFile::for_each_order_in(std::string_view(BinaryOrderFile::magic, 8), symbols, [](const Order&) {});
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    tf.assert_true("Truncated binary file rejected", rejected);
+}
+
+// Journal d'événements binaire relu et converti en CSV : identique au CSV écrit directement
+void test_binary_event_log(TestFramework& tf) {
+    std::cout << "\n=== Testing Binary Event Log ===\n";
+
+    std::string text = "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+    TickSize cents;
+    char price[TickSize::max_formatted_size];
+    for (const auto& order : random_order_flow(17, 2000)) {
+        text += std::to_string(order.timestamp) + "," + std::to_string(order.order_id) + "," +
+                test_symbols.name(order.instrument) + "," + to_string(order.side) + "," + to_string(order.type) + "," +
+                std::to_string(order.quantity) + "," + std::string(price, cents.format(price, order.price)) + "," +
+                to_string(order.action) + "\n";
+    }
+    text += "1800000000000000000,5000,EURUSD,Hold,LIMIT,5,1.00001,NEW\n";
+    SymbolTable symbols;
+    TickSize pip;
+    TickSize::parse("0.00001", pip);
+    symbols.set_tick_size("EURUSD", pip);
+    std::vector<Order> orders;
+    CSVParser::for_each_order_in(text, symbols, [&orders](const Order& order) { orders.push_back(order); });
+
+    {
+        CSVSink csv_sink("event_log_direct.csv", symbols);
+        BinaryEventSink binary_sink("event_log_test.bin", symbols);
+        MatchingEngine csv_engine, binary_engine;
+        csv_engine.set_sink(&csv_sink);
+        binary_engine.set_sink(&binary_sink);
+        for (const auto& order : orders) {
+            csv_engine.process_order(order);
+            binary_engine.process_order(order);
+        }
+        tf.assert_true("Binary log has one record per event", csv_sink.row_count() == binary_sink.row_count());
+    }
+
+    {
+        SymbolTable log_symbols;
+        CSVSink sink("event_log_dump.csv", log_symbols);
+        BinaryEventFile::for_each_report("event_log_test.bin", log_symbols,
+                                         [&sink](const ExecutionReport& report) { sink.on_report(report); });
+    }
+    auto read_all = [](const std::string& filename) {
+        std::ifstream in(filename);
+        std::ostringstream content;
+        content << in.rdbuf();
+        return content.str();
+    };
+    std::string direct = read_all("event_log_direct.csv");
+    tf.assert_true("Binary log dumps to the same CSV",
+                   direct == read_all("event_log_dump.csv") && direct.find("HOLD") != std::string::npos);
+}
+
+// Le même flux rejoué par le moteur séquentiel puis par le moteur réparti
+void test_sharded_engine(TestFramework& tf) {
+    std::cout << "\n=== Testing Sharded Engine ===\n";
+
+    std::vector<Order> orders = random_order_flow(42, 4000);
+    MatchingEngine serial;
+    CollectingSink expected;
+    serial.set_sink(&expected);
+    for (const auto& order : orders) serial.process_order(order);
+
+    bool all_same = true;
+    for (size_t shard_count : {2, 3}) {
+        CollectingSink sink;
+        ShardedMatchingEngine sharded(shard_count, sink, 64);
+        for (const auto& order : orders) sharded.process_order(order);
+        sharded.finish();
+        all_same = all_same && same_reports(expected.reports, sink.reports);
+    }
+    tf.assert_true("Sharded output identical to serial output (2 and 3 shards)", all_same);
+    tf.assert_true("Sharded flow produced executions", expected.reports.size() > orders.size());
+
+    // Même ID sur deux instruments de shards différents : le second est rejeté à la distribution
+    CollectingSink duplicates;
+    {
+        ShardedMatchingEngine sharded(2, duplicates);
+        Order first = create_order(1617278400000000000ULL, 7, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+        Order second = first;
+        second.timestamp += 100;
+        second.instrument = first.instrument + 1;
+        sharded.process_order(first);
+        sharded.process_order(second);
+        sharded.finish();
+    }
+    tf.assert_true("Duplicate ID across shards rejected",
+                   duplicates.reports.size() == 2 && duplicates.reports[1].status == Status::REJECTED);
+
+    // Destruction sans finish (exception côté appelant) avec des files d'événements pleines :
+    // les shards abandonnent au lieu d'attendre une remise qui n'aura jamais lieu
+    auto abandoned_sink = std::make_shared<CollectingSink>();
+    auto abandoned = new ShardedMatchingEngine(2, *abandoned_sink, 2);
+    uint64_t timestamp = 1617278400000000000ULL;
+    for (uint64_t id = 1; id <= 20; ++id) {
+        abandoned->process_order(create_order(timestamp += 100, id, "AAPL", "SELL", "LIMIT", 10, 15000, "NEW"));
+    }
+    abandoned->process_order(create_order(timestamp += 100, 21, "AAPL", "BUY", "LIMIT", 200, 15000, "NEW"));
+    auto destroyed = std::make_shared<std::atomic<bool>>(false);
+    std::thread destroyer([abandoned, abandoned_sink, destroyed]() {
+        delete abandoned;
+        destroyed->store(true);
+    });
+    for (int i = 0; i < 500 && !destroyed->load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool returned = destroyed->load();
+    if (returned) destroyer.join();
+    else destroyer.detach();
+    tf.assert_true("Engine destroyed with full rings without finish()", returned);
+}
+
+// Soumission par lots : même sortie que le traitement ordre par ordre, quelle que soit la taille des lots
+void test_batch_submission(TestFramework& tf) {
+    std::cout << "\n=== Testing Batch Submission ===\n";
+
+    std::vector<Order> orders = random_order_flow(11, 3000);
+    for (size_t i = 0; i < orders.size(); i += 97) orders[i].status = Status::REJECTED;
+
+    CollectingSink expected;
+    MatchingEngine serial;
+    serial.set_default_price_ladder(64);
+    serial.set_sink(&expected);
+    for (const auto& order : orders) serial.process_order(order);
+
+    bool all_same = true;
+    for (size_t batch_size : {1, 7, 256, 3000}) {
+        CollectingSink sink;
+        MatchingEngine engine;
+        engine.set_default_price_ladder(64);
+        engine.set_sink(&sink);
+        for (size_t start = 0; start < orders.size(); start += batch_size) {
+            engine.process_batch(orders.data() + start, std::min(batch_size, orders.size() - start));
+        }
+        all_same = all_same && same_reports(expected.reports, sink.reports);
+    }
+    tf.assert_true("Batched output identical to per-order output (1, 7, 256, 3000)", all_same);
+}
+
+// Moteurs indépendants : chacun a son séquenceur, résultats identiques quel que soit l'entrelacement
+void test_independent_engines(TestFramework& tf) {
+    std::cout << "\n=== Testing Independent Engines ===\n";
+
+    std::vector<Order> orders = random_order_flow(7, 3000);
+    CollectingSink expected;
+    {
+        MatchingEngine engine;
+        engine.set_sink(&expected);
+        for (const auto& order : orders) engine.process_order(order);
+    }
+
+    // Deux moteurs entrelacés sur le même thread
+    MatchingEngine first;
+    MatchingEngine second;
+    CollectingSink first_sink;
+    CollectingSink second_sink;
+    first.set_sink(&first_sink);
+    second.set_sink(&second_sink);
+    for (const auto& order : orders) {
+        first.process_order(order);
+        second.process_order(order);
+    }
+    tf.assert_true("Interleaved engines keep their own clock",
+                   same_reports(expected.reports, first_sink.reports) &&
+                   same_reports(expected.reports, second_sink.reports));
+
+    // Quatre moteurs en parallèle
+    std::vector<CollectingSink> sinks(4);
+    std::vector<std::thread> threads;
+    for (auto& sink : sinks) {
+        threads.emplace_back([&orders, &sink]() {
+            MatchingEngine engine;
+            engine.set_sink(&sink);
+            for (const auto& order : orders) engine.process_order(order);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    bool all_same = true;
+    for (const auto& sink : sinks) all_same = all_same && same_reports(expected.reports, sink.reports);
+    tf.assert_true("Concurrent engines produce identical results", all_same);
+}
+
+void test_work_stealing_pool(TestFramework& tf) {
+    std::cout << "\n=== Testing Work-Stealing Pool ===\n";
+
+    // Un moteur par tâche : même flux, résultats identiques sur chaque worker
+    std::vector<Order> orders = random_order_flow(11, 1000);
+    CollectingSink expected;
+    {
+        MatchingEngine engine;
+        engine.set_sink(&expected);
+        for (const auto& order : orders) engine.process_order(order);
+    }
+
+    std::vector<CollectingSink> sinks(12);
+    std::atomic<int> nested(0);
+    WorkStealingPool pool(3);
+    for (auto& sink : sinks) {
+        pool.submit([&orders, &sink]() {
+            MatchingEngine engine;
+            engine.set_sink(&sink);
+            for (const auto& order : orders) engine.process_order(order);
+        });
+    }
+    // Tâches soumises depuis une tâche
+    pool.submit([&pool, &nested]() {
+        for (int i = 0; i < 10; ++i) pool.submit([&nested]() { nested++; });
+    });
+    pool.wait();
+
+    bool all_same = true;
+    for (const auto& sink : sinks) all_same = all_same && same_reports(expected.reports, sink.reports);
+    tf.assert_true("Every pooled replay matches the serial run", all_same);
+    tf.assert_equal("Nested submissions all executed", 10, nested.load());
+}
+
 void test_timestamp_ordering(TestFramework& tf) {
     std::cout << "\n=== Testing Timestamp Ordering ===\n";
     
     MatchingEngine engine;
     
     // Ajout d'ordre avec différents timestamps
-    Order order1 = create_order(1617278400000000300ULL, 1, "AAPL", "BUY", "LIMIT", 100, 150.25, "NEW");
-    Order order2 = create_order(1617278400000000100ULL, 2, "AAPL", "BUY", "LIMIT", 100, 150.20, "NEW");
-    Order order3 = create_order(1617278400000000200ULL, 3, "AAPL", "BUY", "LIMIT", 100, 150.30, "NEW");
+    Order order1 = create_order(1617278400000000300ULL, 1, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+    Order order2 = create_order(1617278400000000100ULL, 2, "AAPL", "BUY", "LIMIT", 100, 15020, "NEW");
+    Order order3 = create_order(1617278400000000200ULL, 3, "AAPL", "BUY", "LIMIT", 100, 15030, "NEW");
     
     engine.process_order(order1);
     engine.process_order(order2);
     engine.process_order(order3);
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     
     // Les résultats devraient être ordonnés par timestamps
     bool correctly_ordered = true;
@@ -360,6 +1383,21 @@ void test_timestamp_ordering(TestFramework& tf) {
     }
     
     tf.assert_true("Results ordered by timestamp", correctly_ordered);
+
+    // Timestamps égaux entre carnets : l'ordre d'émission départage (rejets au timestamp d'entrée)
+    MatchingEngine merged;
+    Order googl = create_order(1617278400000005000ULL, 10, "GOOGL", "BUY", "LIMIT", 100, 15025, "NEW");
+    Order aapl_same = create_order(1617278400000005000ULL, 11, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+    Order aapl_early = create_order(1617278400000004000ULL, 12, "AAPL", "BUY", "LIMIT", 100, 15025, "NEW");
+    googl.status = aapl_same.status = aapl_early.status = Status::REJECTED;
+    merged.process_order(googl);
+    merged.process_order(aapl_same);
+    merged.process_order(aapl_early);
+
+    std::vector<ExecutionReport> merged_results = merged.get_all_results();
+    tf.assert_true("Merge keeps emission order on ties",
+                   merged_results.size() == 3 && merged_results[0].order_id == 12 &&
+                   merged_results[1].order_id == 10 && merged_results[2].order_id == 11);
 }
 
 void run_performance_test(TestFramework& tf) {
@@ -372,7 +1410,7 @@ void run_performance_test(TestFramework& tf) {
     for (int i = 1; i <= 1000; i++) {
         Order order = create_order(1617278400000000000ULL + i, i, "AAPL", 
                                   (i % 2 == 0) ? "BUY" : "SELL", "LIMIT", 100, 
-                                  150.0 + (i % 10) * 0.01, "NEW");
+                                  150.0 + (i % 10) * 1, "NEW");
         engine.process_order(order);
     }
     
@@ -381,7 +1419,7 @@ void run_performance_test(TestFramework& tf) {
     
     std::cout << "Processed 1000 orders in " << duration.count() / 1000.0 << " ms\n";
     
-    std::vector<Order> results = engine.get_all_results();
+    std::vector<ExecutionReport> results = engine.get_all_results();
     tf.assert_true("Performance test completed", results.size() > 0);
     
     // Performance acceptable (moins de 100ms pour 1000 ordres)
@@ -398,16 +1436,35 @@ int main() {
         // Core functionality tests
         test_exact_expected_output(tf);
         test_validation_comprehensive(tf);
+        test_tick_price_conversion(tf);
         test_csv_parsing_errors(tf);
+        test_in_memory_parsing(tf);
+        test_streamed_input(tf);
+        test_csv_tokenizer_paths(tf);
+        test_parallel_parsing(tf);
+        test_binary_orders(tf);
+        test_binary_event_log(tf);
         
         // Matching engine tests
         test_order_book_matching(tf);
         test_modify_order_behavior(tf);
+        test_modify_priority(tf);
         test_cancel_order_behavior(tf);
+        test_cancel_preserves_time_priority(tf);
         test_duplicate_order_handling(tf);
         
         // Advanced tests
         test_multi_instrument_support(tf);
+        test_price_ladder_matches_tree(tf);
+        test_book_pool_allocations(tf);
+        test_order_index(tf);
+        test_order_retention(tf);
+        test_result_sink(tf);
+        test_sharded_engine(tf);
+        test_batch_submission(tf);
+        test_pipeline(tf);
+        test_independent_engines(tf);
+        test_work_stealing_pool(tf);
         test_timestamp_ordering(tf);
         run_performance_test(tf);
         
@@ -420,7 +1477,9 @@ int main() {
     
     // Cleanup
     std::cout << "\nCleaning up test files...\n";
-    [[maybe_unused]] int cleanup_status = system("rm -f input.csv output.csv error_test.csv");
+    [[maybe_unused]] int cleanup_status = system("rm -f input.csv output.csv error_test.csv tick_test.csv writer_test.csv orders_test.bin "
+                                                  "event_log_test.bin event_log_direct.csv event_log_dump.csv "
+                                                  "pipeline_test.csv pipeline_output.csv pipeline_serial_output.csv");
 
     return (tf.get_passed_tests() == tf.get_total_tests()) ? 0 : 1;
 }
\ No newline at end of file